@@ -63,6 +63,12 @@ void setup() {
   SERIAL_PORT_MONITOR.println(F("BENCHMARKS"));
   runBenchmarks();
 
+  SERIAL_PORT_MONITOR.println(F("FIXED"));
+  runFixedBenchmarks();
+
+  SERIAL_PORT_MONITOR.println(F("SELECTION"));
+  runSelectionBenchmarks();
+
   SERIAL_PORT_MONITOR.println(F("END"));
 
 #if defined(EPOXY_DUINO)
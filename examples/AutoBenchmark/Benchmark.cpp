@@ -26,9 +26,25 @@ using ace_sorting::combSort13;
 using ace_sorting::combSort13m;
 using ace_sorting::combSort133;
 using ace_sorting::combSort133m;
+using ace_sorting::heapSort;
+using ace_sorting::partialSort;
+using ace_sorting::topK;
+using ace_sorting::median;
 using ace_sorting::quickSortMiddle;
 using ace_sorting::quickSortMedian;
 using ace_sorting::quickSortMedianSwapped;
+using ace_sorting::quickSortIterative;
+using ace_sorting::quickSort3Way;
+using ace_sorting::quickSortBlock;
+using ace_sorting::pdqSort;
+using ace_sorting::introSort;
+using ace_sorting::mergeSort;
+using ace_sorting::mergeSortInPlace;
+using ace_sorting::timSort;
+using ace_sorting::radixSort;
+using ace_sorting::radixSortInPlace;
+using ace_sorting::countingSort;
+using ace_sorting::sortFixed;
 
 //-----------------------------------------------------------------------------
 // Benchmark parameters.
@@ -57,6 +73,25 @@ const uint16_t FAST_SAMPLE_SIZE = 20;
 #endif
 const uint16_t NUM_DATA_SIZES = sizeof(DATA_SIZES) / sizeof(DATA_SIZES[0]);
 
+// Number of unique keys in the "few unique" data set, similar to sensor
+// readings which contain many duplicates. The benchmarks for this data set are
+// labeled with a "/16" suffix.
+const uint16_t FEW_UNIQUE_KEYS = 16;
+
+// Number of unique keys in the "byte" data set, the same range as uint8_t
+// data, which can be sorted by countingSort(). The benchmarks for this data
+// set are labeled with a "/256" suffix.
+const uint16_t BYTE_KEYS = 256;
+
+// Number of largest elements selected by the top-K benchmarks, e.g. the peaks
+// of a buffer of sensor readings.
+const uint16_t TOP_K = 10;
+
+// Total number of elements sorted by the fixed size benchmarks, split into
+// arrays of N elements which are sorted one after another. Sorting many small
+// arrays makes the elapsed time long enough to be measured by micros().
+const uint16_t FIXED_DATA_SIZE = 480;
+
 //-----------------------------------------------------------------------------
 // Stats helpers
 //-----------------------------------------------------------------------------
@@ -111,9 +146,13 @@ volatile uint32_t disableCompilerOptimization;
 // degenerate into a function pointer.
 uint16_t* array;
 
+// Number of unique keys generated by fillArray(). This is a global variable
+// for the same reason as 'array'.
+uint32_t numKeys = 65536;
+
 static void fillArray(uint16_t data[], uint16_t n) {
   for (uint16_t i = 0; i < n; ++i) {
-    data[i] = random(65536);
+    data[i] = random(numKeys);
   }
 }
 
@@ -127,6 +166,31 @@ static void doQsort(uint16_t data[], uint16_t n) {
   qsort(data, n, sizeof(uint16_t), compare);
 }
 
+// Scratch buffer for mergeSort(), timSort() and radixSort(), allocated by
+// runSort() only when doMergeSort(), doTimSort() or doRadixSort() is being
+// benchmarked, to avoid including the cost of malloc() in the timing.
+uint16_t* buffer;
+
+static void doMergeSort(uint16_t data[], uint16_t n) {
+  mergeSort(data, n, buffer);
+}
+
+static void doTimSort(uint16_t data[], uint16_t n) {
+  timSort(data, n, buffer);
+}
+
+static void doRadixSort(uint16_t data[], uint16_t n) {
+  radixSort(data, n, buffer);
+}
+
+// Table of 'numKeys' counters for countingSort(), allocated by runSort() only
+// when doCountingSort() is being benchmarked.
+uint16_t* counts;
+
+static void doCountingSort(uint16_t data[], uint16_t n) {
+  countingSort(data, n, (uint16_t) (numKeys - 1), counts);
+}
+
 static void runSort(
     const __FlashStringHelper* name,
     uint16_t dataSize,
@@ -135,6 +199,13 @@ static void runSort(
 
   timingStats.reset();
   array = new uint16_t[dataSize];
+  if (sortFunction == doMergeSort || sortFunction == doTimSort) {
+    buffer = new uint16_t[dataSize / 2];
+  } else if (sortFunction == doRadixSort) {
+    buffer = new uint16_t[dataSize];
+  } else if (sortFunction == doCountingSort) {
+    counts = new uint16_t[numKeys];
+  }
 
   for (uint8_t k = 0; k < sampleSize; k++) {
     fillArray(array, dataSize);
@@ -157,6 +228,13 @@ static void runSort(
     timingStats.update((float) elapsedMicros / 1000.0);
   }
 
+  if (sortFunction == doMergeSort
+      || sortFunction == doTimSort
+      || sortFunction == doRadixSort) {
+    delete[] buffer;
+  } else if (sortFunction == doCountingSort) {
+    delete[] counts;
+  }
   delete[] array;
   printStats(name, timingStats, sampleSize, dataSize);
 }
@@ -180,6 +258,16 @@ static void runSortForSizes(
     #if defined(ARDUINO_AVR_PROMICRO)
       if (sortFunction == doQsort && dataSize >= 1000) break;
     #endif
+    // Don't run mergeSort(), timSort(), radixSort() or countingSort() for
+    // N>=1000 on Pro Micro because there is not enough ram for the additional
+    // scratch buffer or table of counters.
+    #if defined(ARDUINO_AVR_PROMICRO)
+      if ((sortFunction == doMergeSort
+            || sortFunction == doTimSort
+            || sortFunction == doRadixSort
+            || sortFunction == doCountingSort)
+          && dataSize >= 1000) break;
+    #endif
 
     // Don't run bubbleSort() with N>=1000 any AVR because it takes too long.
     #if defined(ARDUINO_ARCH_AVR)
@@ -220,6 +308,9 @@ void runBenchmarks() {
   runSortForSizes(
       F("combSort133m()"), FAST_SAMPLE_SIZE, combSort133m<uint16_t>);
 
+  runSortForSizes(
+      F("heapSort()"), FAST_SAMPLE_SIZE, heapSort<uint16_t>);
+
   runSortForSizes(
       F("quickSortMiddle()"), FAST_SAMPLE_SIZE, quickSortMiddle<uint16_t>);
   runSortForSizes(
@@ -228,6 +319,263 @@ void runBenchmarks() {
       F("quickSortMedianSwapped()"),
       FAST_SAMPLE_SIZE,
       quickSortMedianSwapped<uint16_t>);
+  runSortForSizes(
+      F("quickSortIterative()"),
+      FAST_SAMPLE_SIZE,
+      quickSortIterative<uint16_t>);
+  runSortForSizes(
+      F("quickSort3Way()"), FAST_SAMPLE_SIZE, quickSort3Way<uint16_t>);
+  runSortForSizes(
+      F("quickSortBlock()"), FAST_SAMPLE_SIZE, quickSortBlock<uint16_t>);
+  runSortForSizes(
+      F("introSort()"), FAST_SAMPLE_SIZE, introSort<uint16_t>);
+  runSortForSizes(
+      F("pdqSort()"), FAST_SAMPLE_SIZE, pdqSort<uint16_t>);
+  runSortForSizes(
+      F("mergeSort()"), FAST_SAMPLE_SIZE, doMergeSort);
+  runSortForSizes(
+      F("mergeSortInPlace()"), FAST_SAMPLE_SIZE, mergeSortInPlace<uint16_t>);
+  runSortForSizes(
+      F("timSort()"), FAST_SAMPLE_SIZE, doTimSort);
+  runSortForSizes(
+      F("radixSort()"), FAST_SAMPLE_SIZE, doRadixSort);
+  runSortForSizes(
+      F("radixSortInPlace()"), FAST_SAMPLE_SIZE, radixSortInPlace<uint16_t>);
   runSortForSizes(
       F("qsort()"), FAST_SAMPLE_SIZE, doQsort);
+
+  // Data set with only a few unique keys.
+  numKeys = FEW_UNIQUE_KEYS;
+  runSortForSizes(
+      F("shellSortKnuth/16"), FAST_SAMPLE_SIZE, shellSortKnuth<uint16_t>);
+  runSortForSizes(
+      F("quickSortMiddle/16"), FAST_SAMPLE_SIZE, quickSortMiddle<uint16_t>);
+  runSortForSizes(
+      F("quickSortMedian/16"), FAST_SAMPLE_SIZE, quickSortMedian<uint16_t>);
+  runSortForSizes(
+      F("quickSort3Way/16"), FAST_SAMPLE_SIZE, quickSort3Way<uint16_t>);
+  runSortForSizes(
+      F("introSort/16"), FAST_SAMPLE_SIZE, introSort<uint16_t>);
+  runSortForSizes(
+      F("pdqSort/16"), FAST_SAMPLE_SIZE, pdqSort<uint16_t>);
+
+  // Data set with the same range as uint8_t.
+  numKeys = BYTE_KEYS;
+  runSortForSizes(
+      F("shellSortKnuth/256"), FAST_SAMPLE_SIZE, shellSortKnuth<uint16_t>);
+  runSortForSizes(
+      F("countingSort/256"), FAST_SAMPLE_SIZE, doCountingSort);
+  numKeys = 65536;
+}
+
+//-----------------------------------------------------------------------------
+// Fixed size benchmarks
+//-----------------------------------------------------------------------------
+
+// Typedef of a function that sorts an array whose size is a compile-time
+// constant.
+typedef void (*FixedSortFunction)(uint16_t data[]);
+
+template <uint8_t N>
+static void doInsertionSortFixed(uint16_t data[]) {
+  insertionSort(data, N);
+}
+
+/**
+ * Sort FIXED_DATA_SIZE / n arrays of `n` elements, and print the average
+ * duration of sorting one array, in micros.
+ */
+static void runFixedSort(
+    const __FlashStringHelper* name,
+    uint8_t n,
+    uint16_t sampleSize,
+    FixedSortFunction sortFunction) {
+
+  const uint16_t numArrays = FIXED_DATA_SIZE / n;
+  timingStats.reset();
+  array = new uint16_t[FIXED_DATA_SIZE];
+
+  for (uint8_t k = 0; k < sampleSize; k++) {
+    fillArray(array, FIXED_DATA_SIZE);
+
+    yield();
+    uint32_t startMicros = micros();
+    for (uint16_t i = 0; i < numArrays; i++) {
+      sortFunction(array + i * n);
+    }
+    uint32_t elapsedMicros = micros() - startMicros;
+    yield();
+    disableCompilerOptimization = array[0];
+
+    for (uint16_t i = 0; i < numArrays; i++) {
+      if (! isSorted(array + i * n, n)) {
+        SERIAL_PORT_MONITOR.println(F("Sorted array is NOT sorted!"));
+        break;
+      }
+    }
+    timingStats.update((float) elapsedMicros / numArrays);
+  }
+
+  delete[] array;
+  printStats(name, timingStats, sampleSize, n);
+}
+
+template <uint8_t N>
+static void runFixedSortForSize() {
+  runFixedSort(
+      F("insertionSort()"), N, FAST_SAMPLE_SIZE, doInsertionSortFixed<N>);
+  runFixedSort(F("sortFixed()"), N, FAST_SAMPLE_SIZE, sortFixed<N, uint16_t>);
+}
+
+void runFixedBenchmarks() {
+  runFixedSortForSize<3>();
+  runFixedSortForSize<5>();
+  runFixedSortForSize<8>();
+  runFixedSortForSize<16>();
+  runFixedSortForSize<32>();
+}
+
+//-----------------------------------------------------------------------------
+// Selection benchmarks
+//-----------------------------------------------------------------------------
+
+// Typedef of a function that copies the TOP_K largest elements of data[] into
+// result[], largest first.
+typedef void (*TopKFunction)(uint16_t data[], uint16_t n, uint16_t result[]);
+
+static void copyLargest(
+    const uint16_t sorted[], uint16_t n, uint16_t result[]) {
+  for (uint16_t i = 0; i < TOP_K; i++) {
+    result[i] = sorted[n - 1 - i];
+  }
+}
+
+static void doShellSortKnuthTopK(
+    uint16_t data[], uint16_t n, uint16_t result[]) {
+  shellSortKnuth(data, n);
+  copyLargest(data, n, result);
+}
+
+static void doQuickSortMiddleTopK(
+    uint16_t data[], uint16_t n, uint16_t result[]) {
+  quickSortMiddle(data, n);
+  copyLargest(data, n, result);
+}
+
+static void doPartialSortTopK(uint16_t data[], uint16_t n, uint16_t result[]) {
+  partialSort(data, n, TOP_K, [](uint16_t a, uint16_t b) { return a > b; });
+  for (uint16_t i = 0; i < TOP_K; i++) {
+    result[i] = data[i];
+  }
+}
+
+static void doTopK(uint16_t data[], uint16_t n, uint16_t result[]) {
+  topK(data, n, result, TOP_K);
+}
+
+// Verify that result[] is in descending order, and that fewer than TOP_K
+// elements of data[] are larger than the last one.
+static bool isTopK(const uint16_t data[], uint16_t n, const uint16_t result[]) {
+  for (uint16_t i = 1; i < TOP_K; i++) {
+    if (result[i - 1] < result[i]) return false;
+  }
+  uint16_t numLarger = 0;
+  for (uint16_t i = 0; i < n; i++) {
+    if (data[i] > result[TOP_K - 1]) numLarger++;
+  }
+  return numLarger < TOP_K;
+}
+
+static void runTopK(
+    const __FlashStringHelper* name,
+    uint16_t dataSize,
+    uint16_t sampleSize,
+    TopKFunction topKFunction) {
+
+  timingStats.reset();
+  array = new uint16_t[dataSize];
+  uint16_t result[TOP_K];
+
+  for (uint8_t k = 0; k < sampleSize; k++) {
+    fillArray(array, dataSize);
+
+    yield();
+    uint32_t startMicros = micros();
+    topKFunction(array, dataSize, result);
+    uint32_t elapsedMicros = micros() - startMicros;
+    yield();
+    disableCompilerOptimization = result[0];
+
+    if (! isTopK(array, dataSize, result)) {
+      SERIAL_PORT_MONITOR.println(F("Top K elements are NOT correct!"));
+    }
+    timingStats.update((float) elapsedMicros / 1000.0);
+  }
+
+  delete[] array;
+  printStats(name, timingStats, sampleSize, dataSize);
+}
+
+static void runTopKForSizes(
+    const __FlashStringHelper* name,
+    uint16_t sampleSize,
+    TopKFunction topKFunction) {
+  for (uint16_t i = 0; i < NUM_DATA_SIZES; i++) {
+    uint16_t dataSize = DATA_SIZES[i];
+    if (dataSize < TOP_K) continue;
+    runTopK(name, dataSize, sampleSize, topKFunction);
+  }
+}
+
+// Verify that fewer than half of the elements of data[] are smaller than m,
+// and that more than half are smaller than or equal to m.
+static bool isMedian(const uint16_t data[], uint16_t n, uint16_t m) {
+  uint16_t numSmaller = 0;
+  uint16_t numSmallerOrEqual = 0;
+  for (uint16_t i = 0; i < n; i++) {
+    if (data[i] < m) numSmaller++;
+    if (data[i] <= m) numSmallerOrEqual++;
+  }
+  return numSmaller <= n / 2 && numSmallerOrEqual > n / 2;
+}
+
+static void runMedian(
+    const __FlashStringHelper* name,
+    uint16_t dataSize,
+    uint16_t sampleSize) {
+
+  timingStats.reset();
+  array = new uint16_t[dataSize];
+
+  for (uint8_t k = 0; k < sampleSize; k++) {
+    fillArray(array, dataSize);
+
+    yield();
+    uint32_t startMicros = micros();
+    uint16_t m = median(array, dataSize);
+    uint32_t elapsedMicros = micros() - startMicros;
+    yield();
+    disableCompilerOptimization = m;
+
+    if (! isMedian(array, dataSize, m)) {
+      SERIAL_PORT_MONITOR.println(F("Median is NOT correct!"));
+    }
+    timingStats.update((float) elapsedMicros / 1000.0);
+  }
+
+  delete[] array;
+  printStats(name, timingStats, sampleSize, dataSize);
+}
+
+void runSelectionBenchmarks() {
+  runTopKForSizes(
+      F("shellSortKnuth()"), FAST_SAMPLE_SIZE, doShellSortKnuthTopK);
+  runTopKForSizes(
+      F("quickSortMiddle()"), FAST_SAMPLE_SIZE, doQuickSortMiddleTopK);
+  runTopKForSizes(F("partialSort()"), FAST_SAMPLE_SIZE, doPartialSortTopK);
+  runTopKForSizes(F("topK()"), FAST_SAMPLE_SIZE, doTopK);
+
+  for (uint16_t i = 0; i < NUM_DATA_SIZES; i++) {
+    runMedian(F("median()"), DATA_SIZES[i], FAST_SAMPLE_SIZE);
+  }
 }
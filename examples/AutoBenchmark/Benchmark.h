@@ -2,5 +2,7 @@
 #define ACE_COMMON_BENCHMARK_H
 
 extern void runBenchmarks();
+extern void runFixedBenchmarks();
+extern void runSelectionBenchmarks();
 
 #endif
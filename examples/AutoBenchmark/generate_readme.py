@@ -97,6 +97,105 @@ $ make README.md
 **v1.0.0**
 * Upgrade various tool chains.  No significant changes to runtimes.
 
+**Unreleased**
+* Add `ACE_SORTING_QUICK_SORT_THRESHOLD` to sort small partitions of the
+  `quickSortXxx()` functions using `insertionSort()`. The default value of 1
+  disables it, so the results below are unchanged. See
+  [Quick Sort Threshold](#QuickSortThreshold).
+* Add `quickSort3Way()`.
+* Add a data set with only 16 unique keys, for a subset of the algorithms. The
+  names of these benchmarks have a `/16` suffix. On Linux, `quickSort3Way/16`
+  is about 1.6X faster than `quickSortMiddle/16` for N=1000 to 30000.
+* Add `mergeSort()`. The scratch buffer is allocated before the timing starts.
+  Not run for N=1000 on the Pro Micro, which does not have enough ram for the
+  buffer.
+* Add `mergeSortInPlace()`.
+* Add `radixSort()`. On Linux, it is 15-20X faster than
+  `quickSortMedianSwapped()` for N=3000 to 30000. Not run for N=1000 on the Pro
+  Micro, which does not have enough ram for the buffer.
+* Add `radixSortInPlace()`. On Linux, it is about 3X faster than
+  `quickSortMedianSwapped()` for N=1000 to 30000.
+* Add a data set with 256 unique keys, the same range as `uint8_t`, labeled
+  with a `/256` suffix. Add `countingSort/256`, which is about 20-90X faster
+  than `shellSortKnuth/256` on Linux for N=1000 to 30000. Not run for N=1000
+  on the Pro Micro, which does not have enough ram for the counters.
+* Add a second table for arrays whose size is a compile-time constant, in
+  micros per array. See [Fixed Size](#FixedSize).
+* Add `quickSortBlock()`. On Linux, it is about 2X faster than
+  `quickSortMedianSwapped()` for N=1000 to 30000.
+* Add `pdqSort()` and `pdqSort/16`. On Linux, `pdqSort/16` is about 2.5X
+  faster than `quickSort3Way/16` for N=1000 to 30000.
+* Add `timSort()`. On random data, it is about 10-20% slower than
+  `mergeSort()` on Linux. Not run for N=1000 on the Pro Micro, which does not
+  have enough ram for the buffer.
+* Add a third table comparing `partialSort()` and `topK()` to a full sort,
+  when selecting the 10 largest elements. See [Selection](#Selection).
+* Add `median()` to the third table. On Linux, it is about 6-8X faster than
+  `quickSortMiddle()` for N=3000 to 30000.
+
+<a name="QuickSortThreshold"></a>
+## Quick Sort Threshold
+
+The `ACE_SORTING_QUICK_SORT_THRESHOLD` macro (default 1, disabled) causes the
+`quickSortXxx()` functions to sort partitions of that size or smaller using
+`insertionSort()`. The following values were derived from the
+`insertionSort()` and `quickSortMedianSwapped()` rows of the tables below. The
+crossover point is the `N` where the 2 algorithms take the same time. The
+recommended threshold is half of the crossover, rounded down to an even
+number, because the cutoff also removes the overhead of the function calls for
+the smallest partitions. These thresholds were not measured on the boards
+themselves, so they are only a starting point:
+
+```
++--------------------+-----------+-----------+
+| Board              | Crossover | Threshold |
+|--------------------+-----------+-----------|
+| Arduino Nano       |       ~50 |        24 |
+| SparkFun Pro Micro |       ~50 |        24 |
+| SAMD21 M0 Mini     |       ~20 |        10 |
+| STM32              |       ~35 |        16 |
+| ESP8266            |       ~30 |        14 |
+| ESP32              |       ~25 |        12 |
+| Teensy 3.2         |       ~15 |         6 |
+| Linux x86_64 (-O2) |           |        12 |
++--------------------+-----------+-----------+
+```
+
+Only the Linux value was measured directly, by compiling with
+`-D ACE_SORTING_QUICK_SORT_THRESHOLD=N` and sorting random `uint16_t` arrays of
+N=1000 to 30000. A threshold of 12 made `quickSortMiddle()` and
+`quickSortMedianSwapped()` about 30-35% faster, and the result was fairly flat
+from 8 to 32. The threshold can be set on the other boards by defining the
+macro before including `<AceSorting.h>`.
+
+<a name="FixedSize"></a>
+## Fixed Size
+
+The second table of each board compares `sortFixed<N>()` to `insertionSort()`
+for arrays of N=3, 5, 8, 16 and 32 elements, the size of typical windows of
+sensor samples. Each sample sorts a total of 480 elements as 480/N consecutive
+arrays, and the table shows the average duration of sorting one array in
+micros. On Linux, compiled with `-Os`, `sortFixed<N>()` was 1.3-4.4X faster
+than `insertionSort()`, and 6-12X faster with `-O2` which vectorizes the
+straight-line code of the network.
+
+<a name="Selection"></a>
+## Selection
+
+The third table of each board selects the 10 largest elements of the random
+array, such as the peaks of a buffer of sensor readings, in milliseconds. The
+`shellSortKnuth()` and `quickSortMiddle()` rows sort the whole array then copy
+its last 10 elements. The `partialSort()` row sorts only the first 10 elements
+in descending order, and `topK()` copies them into a separate array without
+modifying the input. Both use a heap of 10 elements, so they run in O(N log K)
+instead of O(N log N). On Linux, they were about 50X faster than
+`quickSortMiddle()` for N=3000, and about 130X faster for N=30000.
+
+The `median()` row finds the median of the same array using `nthElement()`.
+The full sort rows also serve as its baseline, since indexing the middle of
+the sorted array takes the same time as copying its last 10 elements. Its
+runtime is `O(N)` instead of `O(N log(N))`.
+
 ## Results
 
 The following results show the runtime of each sorting function in milliseconds,
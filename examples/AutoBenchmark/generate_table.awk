@@ -12,6 +12,14 @@ BEGIN {
 
   # Set to 1 when 'BENCHMARKS' is detected
   collect_benchmarks = 0
+
+  # Set to 1 when 'FIXED' is detected
+  collect_fixed = 0
+  fixed_index = 0
+
+  # Set to 1 when 'SELECTION' is detected
+  collect_selection = 0
+  selection_index = 0
 }
 
 /^SIZEOF/ {
@@ -28,6 +36,23 @@ BEGIN {
   next
 }
 
+/^FIXED/ {
+  collect_sizeof = 0
+  collect_benchmarks = 0
+  collect_fixed = 1
+  fixed_index = 0
+  next
+}
+
+/^SELECTION/ {
+  collect_sizeof = 0
+  collect_benchmarks = 0
+  collect_fixed = 0
+  collect_selection = 1
+  selection_index = 0
+  next
+}
+
 !/^END/ {
   if (collect_sizeof) {
     s[sizeof_index] = $0
@@ -42,6 +67,18 @@ BEGIN {
     u[benchmark_index]["sampleSize"] = $6
     benchmark_index++
   }
+  if (collect_fixed) {
+    v[fixed_index]["name"] = $1
+    v[fixed_index]["dataSize"] = $2
+    v[fixed_index]["avg"] = $4
+    fixed_index++
+  }
+  if (collect_selection) {
+    w[selection_index]["name"] = $1
+    w[selection_index]["dataSize"] = $2
+    w[selection_index]["avg"] = $4
+    selection_index++
+  }
 }
 
 END {
@@ -74,14 +111,21 @@ END {
     name = names_array[i]
     if (name == "quickSortMedianSwapped()") {
       displayName = "quickSortMdnSwppd()"
+    } else if (name == "quickSortIterative()") {
+      displayName = "quickSortIter()"
     } else {
       displayName = name
     }
     if (name ~ /^bubbleSort\(\)/ \
         || name ~ /^shellSortClassic\(\)/ \
         || name ~ /^combSort13\(\)/ \
+        || name ~ /^heapSort\(\)/ \
         || name ~ /^quickSortMiddle\(\)/ \
+        || name ~ /^mergeSort\(\)/ \
+        || name ~ /^radixSort\(\)/ \
         || name ~ /^qsort\(\)/ \
+        || name ~ /^shellSortKnuth\/16/ \
+        || name ~ /^shellSortKnuth\/256/ \
     ) {
       printf("|---------------------+-------+-------+--------+---------+---------+---------|\n")
     }
@@ -106,4 +150,82 @@ END {
       g[name]["3000"])
   }
   printf("+---------------------+-------+-------+--------+---------+---------+---------+\n")
+
+  # The fixed size benchmarks, in micros per array instead of millis.
+  TOTAL_FIXED = fixed_index
+  if (TOTAL_FIXED == 0) exit
+
+  fixed_name_index = 0
+  for (i = 0; i < TOTAL_FIXED; i++) {
+    name = v[i]["name"]
+    h[name][v[i]["dataSize"]] = v[i]["avg"]
+    if (! (name in fixed_names_map)) {
+      fixed_names_map[name] = fixed_name_index
+      fixed_names_array[fixed_name_index] = name
+      fixed_name_index++
+    }
+  }
+  TOTAL_FIXED_NAMES = fixed_name_index
+
+  printf("\n")
+  printf("+---------------------+--------+--------+--------+--------+--------+\n")
+  printf("|   micros/array \\  N |      3 |      5 |      8 |     16 |     32 |\n")
+  printf("| Function        \\   |        |        |        |        |        |\n")
+  printf("|---------------------+--------+--------+--------+--------+--------|\n")
+  for (i = 0; i < TOTAL_FIXED_NAMES; i++) {
+    name = fixed_names_array[i]
+    printf("| %-19s | %6.2f | %6.2f | %6.2f | %6.2f | %6.2f |\n",
+      name,
+      h[name]["3"],
+      h[name]["5"],
+      h[name]["8"],
+      h[name]["16"],
+      h[name]["32"])
+  }
+  printf("+---------------------+--------+--------+--------+--------+--------+\n")
+
+  # The selection benchmarks, in millis, using the same N as the first table.
+  TOTAL_SELECTION = selection_index
+  if (TOTAL_SELECTION == 0) exit
+
+  selection_name_index = 0
+  for (i = 0; i < TOTAL_SELECTION; i++) {
+    name = w[i]["name"]
+    t[name][w[i]["dataSize"]] = w[i]["avg"]
+    if (! (name in selection_names_map)) {
+      selection_names_map[name] = selection_name_index
+      selection_names_array[selection_name_index] = name
+      selection_name_index++
+    }
+  }
+  TOTAL_SELECTION_NAMES = selection_name_index
+
+  printf("\n")
+  printf("+---------------------+-------+-------+--------+---------+---------+---------+\n")
+  printf("|     select \\      N |    10 |    30 |    100 |     300 |    1000 |    3000 |\n")
+  printf("| Function    \\       |       |       |        |         |         |         |\n")
+  printf("|---------------------+-------+-------+--------+---------+---------+---------|\n")
+  for (i = 0; i < TOTAL_SELECTION_NAMES; i++) {
+    name = selection_names_array[i]
+
+    # If entry is missing for a particular N, print nothing instead of "0.000".
+    t1000 = t[name]["1000"]
+    f1000 = (t1000 == "") ? "%7s" : "%7.3f"
+
+    t3000 = t[name]["3000"]
+    f3000 = (t3000 == "") ? "%7s" : "%7.3f"
+
+    format = sprintf(\
+        "| %%-19s | %%5.3f | %%5.3f | %%6.3f | %%7.3f | %s | %s |\n",
+        f1000, f3000)
+    printf(format,
+      name,
+      t[name]["10"],
+      t[name]["30"],
+      t[name]["100"],
+      t[name]["300"],
+      t[name]["1000"],
+      t[name]["3000"])
+  }
+  printf("+---------------------+-------+-------+--------+---------+---------+---------+\n")
 }
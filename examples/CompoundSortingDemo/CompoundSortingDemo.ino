@@ -1,7 +1,9 @@
 /*
  * Demo of a more complex sorting using a compound key and a lambda expression.
  * This version uses shellSortKnuth(), but all the other sorting algorithms have
- * the exact same function signature.
+ * the exact same function signature. The last section shows how the same
+ * compound sorting can be done with 2 passes of the stable mergeSort(), first
+ * by the secondary key, then by the primary key.
  *
  * Expected output:
  *
@@ -43,6 +45,19 @@
  * Dembe 8
  * Hiromi 9
  * Nasir 10
+ *
+ * Sorted by name, then by score using mergeSort()
+ * -----------------------------------------------
+ * Soren 1
+ * Dimitri 2
+ * Emilia 3
+ * Michael 3
+ * Arun 5
+ * Meilin 6
+ * Petra 6
+ * Dembe 8
+ * Hiromi 9
+ * Nasir 10
  */
 
 #include <string.h> // strcmp()
@@ -50,6 +65,7 @@
 #include <AceSorting.h>
 
 using ace_sorting::shellSortKnuth;
+using ace_sorting::mergeSort;
 
 // ESP32 does not define SERIAL_PORT_MONITOR
 #if ! defined(SERIAL_PORT_MONITOR)
@@ -153,6 +169,35 @@ void setup() {
   printRecords(recordPtrs, ARRAY_SIZE);
   SERIAL_PORT_MONITOR.println();
 
+  // Start from the unsorted order, and sort by the secondary key (name), then
+  // by the primary key (score). The mergeSort() is stable, so records with the
+  // same score remain sorted by name. It needs a scratch buffer of at least
+  // half the size of the array.
+  SERIAL_PORT_MONITOR.println(
+      F("Sorted by name, then by score using mergeSort()"));
+  SERIAL_PORT_MONITOR.println(
+      F("-----------------------------------------------"));
+  fillRecordPointers(recordPtrs, ARRAY_SIZE);
+  const Record* buffer[ARRAY_SIZE / 2];
+  mergeSort(
+      recordPtrs,
+      ARRAY_SIZE,
+      buffer,
+      [](const Record* a, const Record* b) {
+        return strcmp(a->name, b->name) < 0;
+      }
+  );
+  mergeSort(
+      recordPtrs,
+      ARRAY_SIZE,
+      buffer,
+      [](const Record* a, const Record* b) {
+        return a->score < b->score;
+      }
+  );
+  printRecords(recordPtrs, ARRAY_SIZE);
+  SERIAL_PORT_MONITOR.println();
+
 #if defined(EPOXY_DUINO)
   exit(0);
 #endif
@@ -0,0 +1,163 @@
+/*
+MIT License
+
+Copyright (c) 2021 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Measure the cost of a median filter of a sliding window of ADC samples,
+ * in micros per output sample. RunningMedian keeps the window sorted as the
+ * samples arrive, and is compared to copying the window and sorting it again
+ * for each sample using insertionSort() and shellSortKnuth(). Runs on
+ * microcontrollers as well as on Linux or MacOS using EpoxyDuino. The output
+ * is:
+ *
+ * @verbatim
+ * {name} window microsPerSample
+ * @endverbatim
+ */
+
+#include <Arduino.h>
+#include <AceSorting.h>
+
+#if ! defined(SERIAL_PORT_MONITOR)
+#define SERIAL_PORT_MONITOR Serial
+#endif
+
+using ace_sorting::RunningMedian;
+using ace_sorting::insertionSort;
+using ace_sorting::shellSortKnuth;
+
+//-----------------------------------------------------------------------------
+
+#if defined(EPOXY_DUINO)
+  const uint16_t NUM_SAMPLES = 20000;
+#else
+  const uint16_t NUM_SAMPLES = 256;
+#endif
+
+// Prevent the compiler from optimizing away the median calculations.
+volatile uint16_t disableCompilerOptimization;
+
+// 10-bit ADC samples.
+uint16_t samples[NUM_SAMPLES];
+
+static void printResult(
+    const __FlashStringHelper* name, uint16_t window, uint32_t elapsedMicros) {
+  SERIAL_PORT_MONITOR.print(name);
+  SERIAL_PORT_MONITOR.print(' ');
+  SERIAL_PORT_MONITOR.print(window);
+  SERIAL_PORT_MONITOR.print(' ');
+  SERIAL_PORT_MONITOR.println((float) elapsedMicros / NUM_SAMPLES, 3);
+}
+
+// Copy the last WINDOW samples from the circular array into a scratch array,
+// sort it, and select the middle element, for each new sample.
+template <uint16_t WINDOW, typename SortFunction>
+static void runResort(
+    const __FlashStringHelper* name, SortFunction sortFunction) {
+  uint16_t window[WINDOW] = {};
+  uint16_t sorted[WINDOW];
+  uint16_t oldest = 0;
+
+  yield();
+  uint32_t startMicros = micros();
+  for (uint16_t i = 0; i < NUM_SAMPLES; i++) {
+    window[oldest] = samples[i];
+    oldest++;
+    if (oldest == WINDOW) oldest = 0;
+
+    for (uint16_t j = 0; j < WINDOW; j++) {
+      sorted[j] = window[j];
+    }
+    sortFunction(sorted, WINDOW);
+    disableCompilerOptimization = sorted[WINDOW / 2];
+  }
+  uint32_t elapsedMicros = micros() - startMicros;
+  yield();
+
+  printResult(name, WINDOW, elapsedMicros);
+}
+
+template <uint16_t WINDOW>
+static void runRunningMedian() {
+  RunningMedian<uint16_t, WINDOW> filter;
+  for (uint16_t i = 0; i < WINDOW; i++) {
+    filter.add(0);
+  }
+
+  yield();
+  uint32_t startMicros = micros();
+  for (uint16_t i = 0; i < NUM_SAMPLES; i++) {
+    filter.add(samples[i]);
+    disableCompilerOptimization = filter.median();
+  }
+  uint32_t elapsedMicros = micros() - startMicros;
+  yield();
+
+  printResult(F("RunningMedian"), WINDOW, elapsedMicros);
+}
+
+template <uint16_t WINDOW>
+static void runBenchmarks() {
+  runResort<WINDOW>(F("insertionSort()"),
+      [](uint16_t data[], uint16_t n) { insertionSort(data, n); });
+  runResort<WINDOW>(F("shellSortKnuth()"),
+      [](uint16_t data[], uint16_t n) { shellSortKnuth(data, n); });
+  runRunningMedian<WINDOW>();
+}
+
+//-----------------------------------------------------------------------------
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // Wait for stability on some boards, otherwise garage on Serial
+#endif
+
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // Wait for Leonardo/Micro
+
+#if defined(EPOXY_DUINO)
+  // On Unix boxes, this should be a good enough random seed.
+  randomSeed(micros());
+#else
+  // Attempt to get some entropy from the floating analog pin.
+  randomSeed(analogRead(A0));
+#endif
+
+  for (uint16_t i = 0; i < NUM_SAMPLES; i++) {
+    samples[i] = random(1024);
+  }
+
+  SERIAL_PORT_MONITOR.println(F("BENCHMARKS"));
+  runBenchmarks<5>();
+  runBenchmarks<9>();
+  runBenchmarks<15>();
+  runBenchmarks<31>();
+  runBenchmarks<63>();
+  SERIAL_PORT_MONITOR.println(F("END"));
+
+#if defined(EPOXY_DUINO)
+  exit(0);
+#endif
+}
+
+void loop() {}
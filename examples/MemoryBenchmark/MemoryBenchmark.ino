@@ -20,6 +20,17 @@ using ace_sorting::combSort133m;
 using ace_sorting::quickSortMiddle;
 using ace_sorting::quickSortMedian;
 using ace_sorting::quickSortMedianSwapped;
+using ace_sorting::introSort;
+using ace_sorting::heapSort;
+using ace_sorting::quickSortIterative;
+using ace_sorting::quickSort3Way;
+using ace_sorting::mergeSort;
+using ace_sorting::mergeSortInPlace;
+using ace_sorting::radixSort;
+using ace_sorting::radixSortInPlace;
+using ace_sorting::quickSortBlock;
+using ace_sorting::pdqSort;
+using ace_sorting::timSort;
 
 // List of features of the AceSorting library that we want to examine.
 #define FEATURE_BASELINE 0
@@ -37,6 +48,17 @@ using ace_sorting::quickSortMedianSwapped;
 #define FEATURE_QUICK_SORT_MEDIAN 12
 #define FEATURE_QUICK_SORT_MEDIAN_SWAPPED 13
 #define FEATURE_QSORT 14
+#define FEATURE_INTRO_SORT 15
+#define FEATURE_HEAP_SORT 16
+#define FEATURE_QUICK_SORT_ITERATIVE 17
+#define FEATURE_QUICK_SORT_3WAY 18
+#define FEATURE_MERGE_SORT 19
+#define FEATURE_MERGE_SORT_IN_PLACE 20
+#define FEATURE_RADIX_SORT 21
+#define FEATURE_RADIX_SORT_IN_PLACE 22
+#define FEATURE_QUICK_SORT_BLOCK 23
+#define FEATURE_PDQ_SORT 24
+#define FEATURE_TIM_SORT 25
 
 // Select one of the FEATURE_* parameter and compile. Then look at the flash
 // and RAM usage, compared to FEATURE_BASELINE usage to determine how much
@@ -57,6 +79,12 @@ void setupData() {
   }
 }
 
+#if FEATURE == FEATURE_MERGE_SORT || FEATURE == FEATURE_TIM_SORT
+uint16_t mergeBuffer[DATA_SIZE / 2];
+#elif FEATURE == FEATURE_RADIX_SORT
+uint16_t radixBuffer[DATA_SIZE];
+#endif
+
 #if FEATURE == FEATURE_QSORT
 int compare(const void* a, const void* b) {
   uint16_t va = *((uint16_t*) a);
@@ -102,6 +130,28 @@ void setup() {
   quickSortMedian(data, DATA_SIZE);
 #elif FEATURE == FEATURE_QUICK_SORT_MEDIAN_SWAPPED
   quickSortMedianSwapped(data, DATA_SIZE);
+#elif FEATURE == FEATURE_INTRO_SORT
+  introSort(data, DATA_SIZE);
+#elif FEATURE == FEATURE_HEAP_SORT
+  heapSort(data, DATA_SIZE);
+#elif FEATURE == FEATURE_QUICK_SORT_ITERATIVE
+  quickSortIterative(data, DATA_SIZE);
+#elif FEATURE == FEATURE_QUICK_SORT_3WAY
+  quickSort3Way(data, DATA_SIZE);
+#elif FEATURE == FEATURE_MERGE_SORT
+  mergeSort(data, DATA_SIZE, mergeBuffer);
+#elif FEATURE == FEATURE_MERGE_SORT_IN_PLACE
+  mergeSortInPlace(data, DATA_SIZE);
+#elif FEATURE == FEATURE_RADIX_SORT
+  radixSort(data, DATA_SIZE, radixBuffer);
+#elif FEATURE == FEATURE_RADIX_SORT_IN_PLACE
+  radixSortInPlace(data, DATA_SIZE);
+#elif FEATURE == FEATURE_QUICK_SORT_BLOCK
+  quickSortBlock(data, DATA_SIZE);
+#elif FEATURE == FEATURE_PDQ_SORT
+  pdqSort(data, DATA_SIZE);
+#elif FEATURE == FEATURE_TIM_SORT
+  timSort(data, DATA_SIZE, mergeBuffer);
 #else
   #error Unknown FEATURE
 #endif
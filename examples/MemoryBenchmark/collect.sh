@@ -15,7 +15,7 @@
 set -eu
 
 PROGRAM_NAME='MemoryBenchmark.ino'
-NUM_FEATURES=14 # excluding Baseline
+NUM_FEATURES=25 # excluding Baseline
 
 # Assume that https://github.com/bxparks/AUniter is installed as a
 # sibling project to AceCommon.
@@ -21,6 +21,17 @@ BEGIN {
   labels[12] = "quickSortMedian()"
   labels[13] = "quickSortMedianSwapped()"
   labels[14] = "qsort()"
+  labels[15] = "introSort()"
+  labels[16] = "heapSort()"
+  labels[17] = "quickSortIterative()"
+  labels[18] = "quickSort3Way()"
+  labels[19] = "mergeSort()"
+  labels[20] = "mergeSortInPlace()"
+  labels[21] = "radixSort()"
+  labels[22] = "radixSortInPlace()"
+  labels[23] = "quickSortBlock()"
+  labels[24] = "pdqSort()"
+  labels[25] = "timSort()"
   record_index = 0
 }
 {
@@ -55,6 +66,9 @@ END {
         || name ~ /^combSort13\(\)/ \
         || name ~ /^quickSortMiddle\(\)/ \
         || name ~ /^qsort\(\)/ \
+        || name ~ /^introSort\(\)/ \
+        || name ~ /^mergeSort\(\)/ \
+        || name ~ /^radixSort\(\)/ \
     ) {
       printf(\
         "|----------------------------------------+--------------+-------------|\n")
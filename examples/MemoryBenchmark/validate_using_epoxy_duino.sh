@@ -8,7 +8,7 @@
 set -eu
 
 PROGRAM_NAME='MemoryBenchmark.ino'
-NUM_FEATURES=14  # excluding FEATURE_BASELINE
+NUM_FEATURES=25  # excluding FEATURE_BASELINE
 temp_out_file=
 
 function cleanup() {
@@ -0,0 +1,178 @@
+/*
+MIT License
+
+Copyright (c) 2021 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Measure how parallelQuickSort() and parallelSampleSort() scale with the
+ * number of threads, on a large array of random uint32_t, compared to the
+ * serial quickSortBlock(), pdqSort() and std::sort(), and to
+ * std::sort(std::execution::par) if the C++17 parallel algorithms are
+ * available. Runs only on Linux or MacOS using EpoxyDuino. The output is:
+ *
+ * @verbatim
+ * {name} dataSize numThreads millis
+ * @endverbatim
+ */
+
+#include <Arduino.h>
+#include <AceSorting.h>
+
+#if ! defined(EPOXY_DUINO)
+  #error This program requires EpoxyDuino on Linux or MacOS
+#endif
+
+#include <algorithm> // std::sort()
+#include <chrono>
+#include <thread>
+#if __cplusplus >= 201703L && defined(__has_include)
+  #if __has_include(<execution>)
+    #include <execution> // std::execution::par
+  #endif
+#endif
+
+using ace_sorting::parallelQuickSort;
+using ace_sorting::parallelSampleSort;
+using ace_sorting::quickSortBlock;
+using ace_sorting::pdqSort;
+
+//-----------------------------------------------------------------------------
+
+const uint32_t DATA_SIZES[] = {1000000, 10000000, 100000000};
+const uint8_t NUM_DATA_SIZES = sizeof(DATA_SIZES) / sizeof(DATA_SIZES[0]);
+
+static void fillArray(uint32_t data[], uint32_t n) {
+  for (uint32_t i = 0; i < n; ++i) {
+    data[i] = ((uint32_t) random(65536) << 16) | random(65536);
+  }
+}
+
+static bool isSorted(const uint32_t data[], uint32_t n) {
+  for (uint32_t i = 1; i < n; ++i) {
+    if (data[i] < data[i - 1]) return false;
+  }
+  return true;
+}
+
+// Sort a copy of 'source' and print the elapsed time. Uses the wall clock of
+// std::chrono instead of millis(), which measures the same thing on
+// EpoxyDuino but makes the intent explicit for multiple threads.
+template <typename SortFunction>
+static void runSort(
+    const __FlashStringHelper* name,
+    const uint32_t source[],
+    uint32_t data[],
+    uint32_t n,
+    uint8_t numThreads,
+    SortFunction sortFunction) {
+  for (uint32_t i = 0; i < n; ++i) {
+    data[i] = source[i];
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  sortFunction(data, n);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  uint32_t elapsedMillis =
+      std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+
+  if (! isSorted(data, n)) {
+    SERIAL_PORT_MONITOR.println(F("Sorted array is NOT sorted!"));
+  }
+  SERIAL_PORT_MONITOR.print(name);
+  SERIAL_PORT_MONITOR.print(' ');
+  SERIAL_PORT_MONITOR.print(n);
+  SERIAL_PORT_MONITOR.print(' ');
+  SERIAL_PORT_MONITOR.print(numThreads);
+  SERIAL_PORT_MONITOR.print(' ');
+  SERIAL_PORT_MONITOR.println(elapsedMillis);
+}
+
+static void runBenchmarks() {
+  unsigned hardwareThreads = std::thread::hardware_concurrency();
+  uint8_t maxThreads = (hardwareThreads == 0) ? 1
+      : (hardwareThreads > 255) ? 255
+      : hardwareThreads;
+
+  for (uint8_t i = 0; i < NUM_DATA_SIZES; i++) {
+    uint32_t n = DATA_SIZES[i];
+    uint32_t* source = new uint32_t[n];
+    uint32_t* data = new uint32_t[n];
+    uint32_t* buffer = new uint32_t[n];
+    fillArray(source, n);
+
+    runSort(F("quickSortBlock()"), source, data, n, 1,
+        [](uint32_t array[], uint32_t size) { quickSortBlock(array, size); });
+    runSort(F("pdqSort()"), source, data, n, 1,
+        [](uint32_t array[], uint32_t size) { pdqSort(array, size); });
+    runSort(F("std::sort()"), source, data, n, 1,
+        [](uint32_t array[], uint32_t size) {
+          std::sort(array, array + size);
+        });
+    // Requires -std=gnu++17, and -ltbb on Linux.
+    #if defined(__cpp_lib_parallel_algorithm)
+      runSort(F("std::sort(par)"), source, data, n, maxThreads,
+          [](uint32_t array[], uint32_t size) {
+            std::sort(std::execution::par, array, array + size);
+          });
+    #endif
+
+    // 1, 2, 4, ... threads, then the number of hardware threads.
+    for (uint16_t threads = 1; ; threads *= 2) {
+      uint8_t numThreads = (threads > maxThreads) ? maxThreads : threads;
+      runSort(F("parallelQuickSort()"), source, data, n, numThreads,
+          [numThreads](uint32_t array[], uint32_t size) {
+            parallelQuickSort(array, size, numThreads);
+          });
+      if (numThreads == maxThreads) break;
+    }
+    for (uint16_t threads = 1; ; threads *= 2) {
+      uint8_t numThreads = (threads > maxThreads) ? maxThreads : threads;
+      runSort(F("parallelSampleSort()"), source, data, n, numThreads,
+          [numThreads, buffer](uint32_t array[], uint32_t size) {
+            parallelSampleSort(array, size, buffer, numThreads);
+          });
+      if (numThreads == maxThreads) break;
+    }
+
+    delete[] buffer;
+    delete[] data;
+    delete[] source;
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+void setup() {
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // Wait for Leonardo/Micro
+
+  // On Unix boxes, this should be a good enough random seed.
+  randomSeed(micros());
+
+  SERIAL_PORT_MONITOR.println(F("BENCHMARKS"));
+  runBenchmarks();
+  SERIAL_PORT_MONITOR.println(F("END"));
+
+  exit(0);
+}
+
+void loop() {}
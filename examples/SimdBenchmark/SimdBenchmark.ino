@@ -0,0 +1,167 @@
+/*
+MIT License
+
+Copyright (c) 2021 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Measure the throughput of quickSortSimd() on large arrays of random
+ * `uint16_t`, `int32_t`, `uint32_t` and `float`, compared to quickSortBlock(),
+ * pdqSort() and std::sort(). Runs only on Linux or MacOS using EpoxyDuino. The
+ * output is:
+ *
+ * @verbatim
+ * {type} {name} dataSize millis millionsOfElementsPerSecond
+ * @endverbatim
+ */
+
+#include <Arduino.h>
+#include <AceSorting.h>
+
+#if ! defined(EPOXY_DUINO)
+  #error This program requires EpoxyDuino on Linux or MacOS
+#endif
+
+#include <algorithm> // std::sort()
+#include <chrono>
+
+using ace_sorting::quickSortBlock;
+using ace_sorting::quickSortSimd;
+using ace_sorting::pdqSort;
+
+//-----------------------------------------------------------------------------
+
+const uint32_t DATA_SIZES[] = {100000, 1000000, 10000000};
+const uint8_t NUM_DATA_SIZES = sizeof(DATA_SIZES) / sizeof(DATA_SIZES[0]);
+
+static uint32_t random32() {
+  return ((uint32_t) random(65536) << 16) | random(65536);
+}
+
+static void fillArray(uint16_t data[], uint32_t n) {
+  for (uint32_t i = 0; i < n; ++i) data[i] = random(65536);
+}
+
+static void fillArray(int32_t data[], uint32_t n) {
+  for (uint32_t i = 0; i < n; ++i) data[i] = (int32_t) random32();
+}
+
+static void fillArray(uint32_t data[], uint32_t n) {
+  for (uint32_t i = 0; i < n; ++i) data[i] = random32();
+}
+
+static void fillArray(float data[], uint32_t n) {
+  for (uint32_t i = 0; i < n; ++i) {
+    data[i] = (float) (int32_t) random32() / 65536.0f;
+  }
+}
+
+template <typename T>
+static bool isSorted(const T data[], uint32_t n) {
+  for (uint32_t i = 1; i < n; ++i) {
+    if (data[i] < data[i - 1]) return false;
+  }
+  return true;
+}
+
+// Sort a copy of 'source' and print the elapsed time and the number of
+// elements sorted per second.
+template <typename T, typename SortFunction>
+static void runSort(
+    const __FlashStringHelper* typeName,
+    const __FlashStringHelper* name,
+    const T source[],
+    T data[],
+    uint32_t n,
+    SortFunction sortFunction) {
+  for (uint32_t i = 0; i < n; ++i) {
+    data[i] = source[i];
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  sortFunction(data, n);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  uint32_t elapsedMicros =
+      std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+
+  if (! isSorted(data, n)) {
+    SERIAL_PORT_MONITOR.println(F("Sorted array is NOT sorted!"));
+  }
+  SERIAL_PORT_MONITOR.print(typeName);
+  SERIAL_PORT_MONITOR.print(' ');
+  SERIAL_PORT_MONITOR.print(name);
+  SERIAL_PORT_MONITOR.print(' ');
+  SERIAL_PORT_MONITOR.print(n);
+  SERIAL_PORT_MONITOR.print(' ');
+  SERIAL_PORT_MONITOR.print(elapsedMicros / 1000.0, 1);
+  SERIAL_PORT_MONITOR.print(' ');
+  SERIAL_PORT_MONITOR.println((float) n / elapsedMicros, 1);
+}
+
+template <typename T>
+static void runBenchmarks(const __FlashStringHelper* typeName) {
+  for (uint8_t i = 0; i < NUM_DATA_SIZES; i++) {
+    uint32_t n = DATA_SIZES[i];
+    T* source = new T[n];
+    T* data = new T[n];
+    fillArray(source, n);
+
+    runSort(typeName, F("quickSortBlock()"), source, data, n,
+        [](T array[], uint32_t size) { quickSortBlock(array, size); });
+    runSort(typeName, F("quickSortSimd()"), source, data, n,
+        [](T array[], uint32_t size) { quickSortSimd(array, size); });
+    runSort(typeName, F("pdqSort()"), source, data, n,
+        [](T array[], uint32_t size) { pdqSort(array, size); });
+    runSort(typeName, F("std::sort()"), source, data, n,
+        [](T array[], uint32_t size) { std::sort(array, array + size); });
+
+    delete[] data;
+    delete[] source;
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+void setup() {
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // Wait for Leonardo/Micro
+
+  // On Unix boxes, this should be a good enough random seed.
+  randomSeed(micros());
+
+  SERIAL_PORT_MONITOR.print(F("AVX2 "));
+#if ACE_SORTING_SIMD_PARTITION
+  SERIAL_PORT_MONITOR.println(ace_sorting::internal::hasAvx2());
+#else
+  SERIAL_PORT_MONITOR.println(0);
+#endif
+
+  SERIAL_PORT_MONITOR.println(F("BENCHMARKS"));
+  runBenchmarks<uint16_t>(F("uint16_t"));
+  runBenchmarks<int32_t>(F("int32_t"));
+  runBenchmarks<uint32_t>(F("uint32_t"));
+  runBenchmarks<float>(F("float"));
+  SERIAL_PORT_MONITOR.println(F("END"));
+
+  exit(0);
+}
+
+void loop() {}
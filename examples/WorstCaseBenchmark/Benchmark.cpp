@@ -7,7 +7,8 @@
  * Determine runtime of potential worst case arrays:
  *  * random
  *  * already sorted
- *  * reverse sorted.
+ *  * reverse sorted
+ *  * concatenation of NUM_RUNS sorted runs.
  */
 
 #include <stdint.h> // uint8_t, uint16_t
@@ -34,9 +35,20 @@ using ace_sorting::combSort13;
 using ace_sorting::combSort13m;
 using ace_sorting::combSort133;
 using ace_sorting::combSort133m;
+using ace_sorting::heapSort;
 using ace_sorting::quickSortMiddle;
 using ace_sorting::quickSortMedian;
 using ace_sorting::quickSortMedianSwapped;
+using ace_sorting::quickSortIterative;
+using ace_sorting::quickSort3Way;
+using ace_sorting::quickSortBlock;
+using ace_sorting::pdqSort;
+using ace_sorting::introSort;
+using ace_sorting::mergeSort;
+using ace_sorting::mergeSortInPlace;
+using ace_sorting::timSort;
+using ace_sorting::radixSort;
+using ace_sorting::radixSortInPlace;
 
 //-----------------------------------------------------------------------------
 // Benchmark parameters.
@@ -56,6 +68,10 @@ const uint16_t SLOW_SAMPLE_SIZE = 3;
 const uint16_t FAST_SAMPLE_SIZE = 20;
 #endif
 
+// Number of sorted runs in the kRuns input, e.g. the concatenated logs of 8
+// sensors, each sorted by timestamp.
+const uint8_t NUM_RUNS = 8;
+
 //-----------------------------------------------------------------------------
 // Stats helpers
 //-----------------------------------------------------------------------------
@@ -66,7 +82,11 @@ const uint16_t FAST_SAMPLE_SIZE = 20;
  *
  * @verbatim
  * name arraySize randomDuration alreadySortedDuration reverseSortedDuration
+ *    sampleSize sortedRunsDuration
  * @endverbatim
+ *
+ * The sortedRunsDuration is last so that generate_table.awk can still read
+ * the older *.txt files which do not contain it.
  */
 static void printStats(
     const __FlashStringHelper* name,
@@ -74,6 +94,7 @@ static void printStats(
     float randomDuration,
     float alreadySortedDuration,
     float reverseSortedDuration,
+    float sortedRunsDuration,
     uint16_t sampleSize) {
   SERIAL_PORT_MONITOR.print(name);
   SERIAL_PORT_MONITOR.print(' ');
@@ -85,7 +106,9 @@ static void printStats(
   SERIAL_PORT_MONITOR.print(' ');
   SERIAL_PORT_MONITOR.print(reverseSortedDuration, 3);
   SERIAL_PORT_MONITOR.print(' ');
-  SERIAL_PORT_MONITOR.println(sampleSize);
+  SERIAL_PORT_MONITOR.print(sampleSize);
+  SERIAL_PORT_MONITOR.print(' ');
+  SERIAL_PORT_MONITOR.println(sortedRunsDuration, 3);
 }
 
 static GenericStats<float> timingStats;
@@ -109,7 +132,7 @@ static void fillArray(uint16_t array[], uint16_t n) {
 }
 
 enum class InputType {
-  kRandom, kSorted, kReversed
+  kRandom, kSorted, kReversed, kRuns
 };
 
 static float measureSort(
@@ -130,6 +153,13 @@ static float measureSort(
       fillArray(array, ARRAY_SIZE);
       shellSortKnuth(array, ARRAY_SIZE);
       reverse(array, ARRAY_SIZE);
+    } else if (inputType == InputType::kRuns) {
+      fillArray(array, ARRAY_SIZE);
+      for (uint8_t r = 0; r < NUM_RUNS; r++) {
+        uint16_t begin = (uint32_t) ARRAY_SIZE * r / NUM_RUNS;
+        uint16_t end = (uint32_t) ARRAY_SIZE * (r + 1) / NUM_RUNS;
+        shellSortKnuth(array + begin, (uint16_t) (end - begin));
+      }
     }
 
     yield();
@@ -148,12 +178,34 @@ static float measureSort(
   return timingStats.getAvg();
 }
 
+// Scratch buffer for mergeSort(), timSort() and radixSort(), allocated by
+// runSort() only when doMergeSort(), doTimSort() or doRadixSort() is being
+// benchmarked, to avoid including the cost of malloc() in the timing.
+uint16_t* buffer;
+
+void doMergeSort(uint16_t array[], uint16_t n) {
+  mergeSort(array, n, buffer);
+}
+
+void doTimSort(uint16_t array[], uint16_t n) {
+  timSort(array, n, buffer);
+}
+
+void doRadixSort(uint16_t array[], uint16_t n) {
+  radixSort(array, n, buffer);
+}
+
 static void runSort(
     const __FlashStringHelper* name,
     uint16_t sampleSize,
     SortFunction sortFunction) {
 
   uint16_t* array = new uint16_t[ARRAY_SIZE];
+  if (sortFunction == doMergeSort || sortFunction == doTimSort) {
+    buffer = new uint16_t[ARRAY_SIZE / 2];
+  } else if (sortFunction == doRadixSort) {
+    buffer = new uint16_t[ARRAY_SIZE];
+  }
 
   // random arrays
   float randomDuration = measureSort(
@@ -168,9 +220,18 @@ static void runSort(
   float reverseSortedDuration = measureSort(
       array, ARRAY_SIZE, sampleSize, sortFunction, InputType::kReversed);
 
+  // concatenation of sorted runs
+  float sortedRunsDuration = measureSort(
+      array, ARRAY_SIZE, sampleSize, sortFunction, InputType::kRuns);
+
+  if (sortFunction == doMergeSort
+      || sortFunction == doTimSort
+      || sortFunction == doRadixSort) {
+    delete[] buffer;
+  }
   delete[] array;
   printStats(name, ARRAY_SIZE, randomDuration, alreadySortedDuration,
-      reverseSortedDuration, sampleSize);
+      reverseSortedDuration, sortedRunsDuration, sampleSize);
 }
 
 int compare(const void* a, const void* b) {
@@ -204,11 +265,28 @@ void runBenchmarks() {
   runSort(F("combSort133()"), FAST_SAMPLE_SIZE, combSort133<uint16_t>);
   runSort(F("combSort133m()"), FAST_SAMPLE_SIZE, combSort133m<uint16_t>);
 
+  runSort(F("heapSort()"), FAST_SAMPLE_SIZE, heapSort<uint16_t>);
+
   runSort(F("quickSortMiddle()"), FAST_SAMPLE_SIZE, quickSortMiddle<uint16_t>);
   runSort(F("quickSortMedian()"), FAST_SAMPLE_SIZE, quickSortMedian<uint16_t>);
   runSort(
       F("quickSortMedianSwapped()"),
       FAST_SAMPLE_SIZE,
       quickSortMedianSwapped<uint16_t>);
+  runSort(
+      F("quickSortIterative()"),
+      FAST_SAMPLE_SIZE,
+      quickSortIterative<uint16_t>);
+  runSort(F("quickSort3Way()"), FAST_SAMPLE_SIZE, quickSort3Way<uint16_t>);
+  runSort(F("quickSortBlock()"), FAST_SAMPLE_SIZE, quickSortBlock<uint16_t>);
+  runSort(F("introSort()"), FAST_SAMPLE_SIZE, introSort<uint16_t>);
+  runSort(F("pdqSort()"), FAST_SAMPLE_SIZE, pdqSort<uint16_t>);
+  runSort(F("mergeSort()"), FAST_SAMPLE_SIZE, doMergeSort);
+  runSort(
+      F("mergeSortInPlace()"), FAST_SAMPLE_SIZE, mergeSortInPlace<uint16_t>);
+  runSort(F("timSort()"), FAST_SAMPLE_SIZE, doTimSort);
+  runSort(F("radixSort()"), FAST_SAMPLE_SIZE, doRadixSort);
+  runSort(
+      F("radixSortInPlace()"), FAST_SAMPLE_SIZE, radixSortInPlace<uint16_t>);
   runSort(F("qsort()"), FAST_SAMPLE_SIZE, doQsort);
 }
@@ -26,11 +26,12 @@ print(f"""\
 # WorstCaseBenchmark
 
 Determine the speed of various AceSorting functions when given data arrays that
-could trigger worst case runtime. Three types of arrays are tested:
+could trigger worst case runtime. Four types of arrays are tested:
 
 * random array
 * already sorted array
 * reverse sorted array
+* array made of 8 sorted runs, such as the concatenated logs of 8 sensors
 
 **Version**: AceSorting v1.0.0
 
@@ -90,6 +91,12 @@ $ make README.md
 **v1.0.0**
 * Upgrade tool chains. No significant change.
 
+**Unreleased**
+* Add a column for arrays made of 8 sorted runs.
+* Add `timSort()`. On Linux, for N=30000, it sorts an already sorted array in
+  about 1% of the time of a random array, and the 8 sorted runs in about 20%,
+  similar to `mergeSort()` and about 3X faster than `quickSortMedianSwapped()`.
+
 ## Results
 
 The following results show the runtime of each sorting function in milliseconds,
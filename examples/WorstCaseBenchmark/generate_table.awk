@@ -40,6 +40,7 @@ BEGIN {
     u[benchmark_index]["sorted"] = $4
     u[benchmark_index]["reversed"] = $5
     u[benchmark_index]["samples"] = $6
+    u[benchmark_index]["runs"] = $7
     benchmark_index++
   }
 }
@@ -48,26 +49,33 @@ END {
   TOTAL_BENCHMARKS = benchmark_index
   TOTAL_SIZEOF = sizeof_index
 
-  printf("+-----------------------------+------+---------+---------+----------+\n")
-  printf("| Function                    |    N |  random |  sorted | reversed |\n")
+  printf("+-----------------------------+------+---------+---------+----------+---------+\n")
+  printf("| Function                    |    N |  random |  sorted | reversed |  8 runs |\n")
 
   for (i = 0; i < TOTAL_BENCHMARKS; i++) {
     name = u[i]["name"]
     if (name ~ /^bubbleSort\(\)/ \
         || name ~ /^shellSortClassic\(\)/ \
         || name ~ /^combSort13\(\)/ \
+        || name ~ /^heapSort\(\)/ \
         || name ~ /^quickSortMiddle\(\)/ \
+        || name ~ /^mergeSort\(\)/ \
+        || name ~ /^radixSort\(\)/ \
         || name ~ /^qsort\(\)/ \
     ) {
-      printf("|-----------------------------+------+---------+---------+----------|\n")
+      printf("|-----------------------------+------+---------+---------+----------+---------|\n")
     }
 
-    printf("| %-27s | %4d | %7.3f | %7.3f |  %7.3f |\n",
+    # Older *.txt files do not contain the sorted runs, print nothing instead.
+    runs = u[i]["runs"]
+    runsLabel = (runs == "") ? "" : sprintf("%7.3f", runs)
+    printf("| %-27s | %4d | %7.3f | %7.3f |  %7.3f | %7s |\n",
       name,
       u[i]["dataSize"],
       u[i]["random"],
       u[i]["sorted"],
-      u[i]["reversed"]);
+      u[i]["reversed"],
+      runsLabel);
   }
-  printf("+-----------------------------+------+---------+---------+----------+\n")
+  printf("+-----------------------------+------+---------+---------+----------+---------+\n")
 }
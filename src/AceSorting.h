@@ -47,11 +47,33 @@ SOFTWARE.
 #define ACE_SORTING_VERSION_STRING "1.0.0"
 
 #include "ace_sorting/swap.h"
+#include "ace_sorting/typeIdentity.h"
 #include "ace_sorting/bubbleSort.h"
 #include "ace_sorting/insertionSort.h"
 #include "ace_sorting/selectionSort.h"
 #include "ace_sorting/shellSort.h"
 #include "ace_sorting/combSort.h"
+#include "ace_sorting/heapSort.h"
+#include "ace_sorting/partialSort.h"
+#include "ace_sorting/nthElement.h"
 #include "ace_sorting/quickSort.h"
+#include "ace_sorting/quickSortBlock.h"
+#include "ace_sorting/quickSortSimd.h"
+#include "ace_sorting/pdqSort.h"
+#include "ace_sorting/parallelQuickSort.h"
+#include "ace_sorting/parallelSampleSort.h"
+#include "ace_sorting/introSort.h"
+#include "ace_sorting/mergeSort.h"
+#include "ace_sorting/mergeSortInPlace.h"
+#include "ace_sorting/timSort.h"
+#include "ace_sorting/kWayMerge.h"
+#include "ace_sorting/radixSort.h"
+#include "ace_sorting/radixSortInPlace.h"
+#include "ace_sorting/countingSort.h"
+#include "ace_sorting/sortingNetwork.h"
+#include "ace_sorting/sortFixed.h"
+#include "ace_sorting/binarySearch.h"
+#include "ace_sorting/SortedBuffer.h"
+#include "ace_sorting/RunningMedian.h"
 
 #endif
@@ -0,0 +1,137 @@
+/*
+MIT License
+
+Copyright (c) 2021 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file RunningMedian.h
+ *
+ * Running median and percentiles of a sliding window of samples, for example
+ * a median filter of noisy ADC readings.
+ */
+
+#ifndef ACE_SORTING_RUNNING_MEDIAN_H
+#define ACE_SORTING_RUNNING_MEDIAN_H
+
+#include <stdint.h> // uint8_t, uint16_t
+#include "SortedBuffer.h"
+
+namespace ace_sorting {
+
+/**
+ * Median and percentiles of the last WINDOW samples. The samples are kept in
+ * a circular array in the order of arrival, which identifies the oldest
+ * sample, and in a SortedBuffer which is always sorted. When the window is
+ * full, each new sample replaces the oldest one using
+ * SortedBuffer::replace(), which costs `O(log(WINDOW))` comparisons and a
+ * shift of the elements between the old and the new positions, `O(WINDOW)` at
+ * worst. The median or any percentile is then read in constant time, instead
+ * of sorting a copy of the window for each output sample.
+ *
+ * Samples which compare equal are assumed to be interchangeable, since the
+ * oldest sample is removed by value.
+ *
+ * @tparam T type of the sample
+ * @tparam WINDOW number of samples in the sliding window
+ * @tparam F type of lambda expression or function object that returns true if
+ *    a < b. A lambda expression must be passed to the constructor.
+ */
+template <typename T, uint16_t WINDOW, typename F = internal::LessThan<T>>
+class RunningMedian {
+  public:
+    /** Constructor. The window is initially empty. */
+    RunningMedian() :
+        mSorted(),
+        mOldest(0)
+    {}
+
+    /** Constructor using the given `lessThan`, required for a lambda. */
+    explicit RunningMedian(const F& lessThan) :
+        mSorted(lessThan),
+        mOldest(0)
+    {}
+
+    /** Number of samples in the full window. */
+    static uint16_t window() { return WINDOW; }
+
+    /** Number of samples added so far, up to WINDOW. */
+    uint16_t size() const { return mSorted.size(); }
+
+    /** Return true if the window holds WINDOW samples. */
+    bool isFull() const { return mSorted.isFull(); }
+
+    /** Remove all samples. */
+    void clear() {
+      mSorted.clear();
+      mOldest = 0;
+    }
+
+    /**
+     * Add a new sample. If the window is full, the oldest sample is removed.
+     */
+    void add(const T& sample) {
+      if (mSorted.isFull()) {
+        mSorted.replace(mSamples[mOldest], sample);
+      } else {
+        mSorted.insert(sample);
+      }
+      mSamples[mOldest] = sample;
+      mOldest++;
+      if (mOldest == WINDOW) mOldest = 0;
+    }
+
+    /**
+     * Return the median of the samples in the window. If the number of samples
+     * is even, return the upper of the 2 middle samples, like median(). At
+     * least one sample must have been added.
+     */
+    const T& median() const { return mSorted.at(mSorted.size() / 2); }
+
+    /**
+     * Return the given percentile (0 to 100) of the samples in the window,
+     * using the nearest-rank method: the smallest sample which is greater
+     * than or equal to `percent` percent of the samples. For example,
+     * percentile(95) of a window of 20 samples is the 19th smallest. At least
+     * one sample must have been added.
+     */
+    const T& percentile(uint8_t percent) const {
+      uint16_t rank = ((uint32_t) percent * mSorted.size() + 99) / 100;
+      return mSorted.at(rank == 0 ? 0 : rank - 1);
+    }
+
+    /** Return the smallest sample in the window. */
+    const T& min() const { return mSorted.min(); }
+
+    /** Return the largest sample in the window. */
+    const T& max() const { return mSorted.max(); }
+
+    /** Return the samples of the window in sorted order. */
+    const SortedBuffer<T, WINDOW, F>& sorted() const { return mSorted; }
+
+  private:
+    SortedBuffer<T, WINDOW, F> mSorted;
+    T mSamples[WINDOW];
+    uint16_t mOldest;
+};
+
+}
+
+#endif
@@ -0,0 +1,211 @@
+/*
+MIT License
+
+Copyright (c) 2021 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file SortedBuffer.h
+ *
+ * A fixed-capacity array which stays sorted as elements are inserted and
+ * removed, without using the heap.
+ */
+
+#ifndef ACE_SORTING_SORTED_BUFFER_H
+#define ACE_SORTING_SORTED_BUFFER_H
+
+#include <stdint.h> // uint16_t
+#include "binarySearch.h"
+
+namespace ace_sorting {
+
+namespace internal {
+
+/**
+ * Default comparison of SortedBuffer, using the implicit less-than operator.
+ * A lambda expression cannot be used as a default template argument, and
+ * cannot be default constructed in C++11.
+ */
+template <typename T>
+struct LessThan {
+  bool operator()(const T& a, const T& b) const { return a < b; }
+};
+
+}
+
+/**
+ * A buffer of at most CAPACITY elements which is always sorted, for example a
+ * small table of recent sensor readings. Instead of sorting the whole array
+ * again after each update (e.g. using insertionSort()), insert() and remove()
+ * find the position using a binary search, then shift the elements after it
+ * by one slot. Each update costs `O(log(N))` comparisons and a single block
+ * move of at most N elements. The elements are stored inside the object, so
+ * no memory is allocated on the heap.
+ *
+ * Equal elements are kept in the order of insertion.
+ *
+ * @tparam T type of the element
+ * @tparam CAPACITY maximum number of elements
+ * @tparam F type of lambda expression or function object that returns true if
+ *    a < b. A lambda expression must be passed to the constructor, e.g.
+ *    `SortedBuffer<int, 8, decltype(lessThan)> buffer(lessThan);`
+ */
+template <typename T, uint16_t CAPACITY, typename F = internal::LessThan<T>>
+class SortedBuffer {
+  public:
+    /** Constructor. The buffer is initially empty. */
+    SortedBuffer() :
+        mLessThan(),
+        mSize(0)
+    {}
+
+    /** Constructor using the given `lessThan`, required for a lambda. */
+    explicit SortedBuffer(const F& lessThan) :
+        mLessThan(lessThan),
+        mSize(0)
+    {}
+
+    /** Maximum number of elements. */
+    static uint16_t capacity() { return CAPACITY; }
+
+    /** Current number of elements. */
+    uint16_t size() const { return mSize; }
+
+    /** Return true if the buffer has no elements. */
+    bool isEmpty() const { return mSize == 0; }
+
+    /** Return true if the buffer holds CAPACITY elements. */
+    bool isFull() const { return mSize == CAPACITY; }
+
+    /** Remove all elements. */
+    void clear() { mSize = 0; }
+
+    /** Return the element at `rank`, 0 being the smallest. */
+    const T& at(uint16_t rank) const { return mData[rank]; }
+
+    /** Return the smallest element. The buffer must not be empty. */
+    const T& min() const { return mData[0]; }
+
+    /** Return the largest element. The buffer must not be empty. */
+    const T& max() const { return mData[mSize - 1]; }
+
+    /**
+     * Return the sorted array of size() elements, to pass to other functions
+     * of this library.
+     */
+    const T* data() const { return mData; }
+
+    /**
+     * Insert `value` after the elements which are equal to it. Return false
+     * if the buffer is full.
+     */
+    bool insert(const T& value) {
+      if (mSize == CAPACITY) return false;
+
+      uint16_t pos = upperBound(value, 0, mSize);
+      for (uint16_t i = mSize; i > pos; i--) {
+        mData[i] = mData[i - 1];
+      }
+      mData[pos] = value;
+      mSize++;
+      return true;
+    }
+
+    /**
+     * Remove the first element which is equal to `value`. Return false if
+     * there is no such element.
+     */
+    bool remove(const T& value) {
+      uint16_t pos = lowerBound(value, 0, mSize);
+      if (pos == mSize || mLessThan(value, mData[pos])) return false;
+      removeAt(pos);
+      return true;
+    }
+
+    /** Remove the element at `rank`, which must be less than size(). */
+    void removeAt(uint16_t rank) {
+      mSize--;
+      for (uint16_t i = rank; i < mSize; i++) {
+        mData[i] = mData[i + 1];
+      }
+    }
+
+    /**
+     * Replace the first element which is equal to `oldValue` with
+     * `newValue`, in a single pass. Only the elements between the old and the
+     * new positions are shifted, by one slot. Return false if there is no
+     * such element. This is the update of a sliding window which is full,
+     * where the oldest sample is replaced by the newest.
+     */
+    bool replace(const T& oldValue, const T& newValue) {
+      uint16_t pos = lowerBound(oldValue, 0, mSize);
+      if (pos == mSize || mLessThan(oldValue, mData[pos])) return false;
+
+      if (mLessThan(newValue, mData[pos])) {
+        // Shift the elements greater than newValue to the right.
+        uint16_t dest = upperBound(newValue, 0, pos);
+        for (uint16_t i = pos; i > dest; i--) {
+          mData[i] = mData[i - 1];
+        }
+        mData[dest] = newValue;
+      } else {
+        // Shift the elements less than or equal to newValue to the left.
+        uint16_t dest = upperBound(newValue, pos + 1, mSize) - 1;
+        for (uint16_t i = pos; i < dest; i++) {
+          mData[i] = mData[i + 1];
+        }
+        mData[dest] = newValue;
+      }
+      return true;
+    }
+
+  private:
+    /**
+     * Return the index of the first element in [lo, hi) which is not less
+     * than `value`, or `hi` if there is none.
+     */
+    uint16_t lowerBound(const T& value, uint16_t lo, uint16_t hi) const {
+      // Don't pass the uninitialized mData[] of an empty range, which causes a
+      // -Wmaybe-uninitialized warning at -Os and -O1.
+      if (lo == hi) return lo;
+      return lo + ace_sorting::lowerBound(
+          mData + lo, (uint16_t) (hi - lo), value, mLessThan);
+    }
+
+    /**
+     * Return the index of the first element in [lo, hi) which is greater than
+     * `value`, or `hi` if there is none.
+     */
+    uint16_t upperBound(const T& value, uint16_t lo, uint16_t hi) const {
+      // Don't pass the uninitialized mData[] of an empty range, which causes a
+      // -Wmaybe-uninitialized warning at -Os and -O1.
+      if (lo == hi) return lo;
+      return lo + ace_sorting::upperBound(
+          mData + lo, (uint16_t) (hi - lo), value, mLessThan);
+    }
+
+    F mLessThan;
+    uint16_t mSize;
+    T mData[CAPACITY];
+};
+
+}
+
+#endif
@@ -0,0 +1,307 @@
+/*
+MIT License
+
+Copyright (c) 2021 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file binarySearch.h
+ *
+ * Binary search of arrays which have been sorted using the same `lessThan` as
+ * the sorting functions of this library. Equivalent to std::lower_bound(),
+ * std::upper_bound() and std::equal_range(), which are not available on AVR.
+ * See https://en.wikipedia.org/wiki/Binary_search_algorithm
+ */
+
+#ifndef ACE_SORTING_BINARY_SEARCH_H
+#define ACE_SORTING_BINARY_SEARCH_H
+
+#include <stdint.h> // uint16_t
+#include "typeIdentity.h"
+
+namespace ace_sorting {
+
+/**
+ * The range [first, last) of the elements which are equal to a given value,
+ * returned by equalRange().
+ *
+ * @tparam S type of the index into data[]
+ */
+template <typename S>
+struct IndexRange {
+  /** Index of the first element equal to the value. */
+  S first;
+
+  /** Index one past the last element equal to the value. */
+  S last;
+};
+
+/**
+ * Return the index of the first element of the sorted data[] which is not
+ * less than `value`, or `n` if there is none. This is the position where
+ * `value` can be inserted before any equal elements.
+ *
+ * Complexity: O(log(n))
+ *
+ * @tparam T type of data
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename S = uint16_t>
+S lowerBound(
+    const T data[], S n,
+    const typename internal::TypeIdentity<T>::type& value) {
+  auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
+  return lowerBound(data, n, value, lessThan);
+}
+
+/**
+ * Same as the 3-argument lowerBound() with the addition of a `lessThan`
+ * lambda expression or function, which must be the same as the one used to
+ * sort data[].
+ *
+ * @tparam T type of data
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename F, typename S = uint16_t>
+S lowerBound(
+    const T data[], S n, const typename internal::TypeIdentity<T>::type& value,
+    F&& lessThan) {
+  S lo = 0;
+  S hi = n;
+  while (lo < hi) {
+    S mid = lo + (hi - lo) / 2;
+    if (lessThan(data[mid], value)) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+/**
+ * Return the index of the first element of the sorted data[] which is
+ * greater than `value`, or `n` if there is none. This is the position where
+ * `value` can be inserted after any equal elements.
+ *
+ * Complexity: O(log(n))
+ *
+ * @tparam T type of data
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename S = uint16_t>
+S upperBound(
+    const T data[], S n,
+    const typename internal::TypeIdentity<T>::type& value) {
+  auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
+  return upperBound(data, n, value, lessThan);
+}
+
+/**
+ * Same as the 3-argument upperBound() with the addition of a `lessThan`
+ * lambda expression or function, which must be the same as the one used to
+ * sort data[].
+ *
+ * @tparam T type of data
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename F, typename S = uint16_t>
+S upperBound(
+    const T data[], S n, const typename internal::TypeIdentity<T>::type& value,
+    F&& lessThan) {
+  S lo = 0;
+  S hi = n;
+  while (lo < hi) {
+    S mid = lo + (hi - lo) / 2;
+    if (lessThan(value, data[mid])) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
+  }
+  return lo;
+}
+
+/**
+ * Return the range [first, last) of the elements of the sorted data[] which
+ * are equal to `value`. If there is none, `first == last` is the position
+ * where `value` can be inserted. The lower bound is searched first, then the
+ * upper bound is searched only in the remaining elements.
+ *
+ * Complexity: O(log(n))
+ *
+ * @tparam T type of data
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename S = uint16_t>
+IndexRange<S> equalRange(
+    const T data[], S n,
+    const typename internal::TypeIdentity<T>::type& value) {
+  auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
+  return equalRange(data, n, value, lessThan);
+}
+
+/**
+ * Same as the 3-argument equalRange() with the addition of a `lessThan`
+ * lambda expression or function, which must be the same as the one used to
+ * sort data[].
+ *
+ * @tparam T type of data
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename F, typename S = uint16_t>
+IndexRange<S> equalRange(
+    const T data[], S n, const typename internal::TypeIdentity<T>::type& value,
+    F&& lessThan) {
+  S first = lowerBound(data, n, value, lessThan);
+  S last = first + upperBound(data + first, (S) (n - first), value, lessThan);
+  return IndexRange<S>{first, last};
+}
+
+/**
+ * Return the index of an element of the sorted data[] which is equal to
+ * `value`, or `n` if there is none. If there are several equal elements, the
+ * first one is returned.
+ *
+ * Complexity: O(log(n))
+ *
+ * @tparam T type of data
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename S = uint16_t>
+S binarySearch(
+    const T data[], S n,
+    const typename internal::TypeIdentity<T>::type& value) {
+  auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
+  return binarySearch(data, n, value, lessThan);
+}
+
+/**
+ * Same as the 3-argument binarySearch() with the addition of a `lessThan`
+ * lambda expression or function, which must be the same as the one used to
+ * sort data[].
+ *
+ * @tparam T type of data
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename F, typename S = uint16_t>
+S binarySearch(
+    const T data[], S n, const typename internal::TypeIdentity<T>::type& value,
+    F&& lessThan) {
+  S i = lowerBound(data, n, value, lessThan);
+  return (i < n && ! lessThan(value, data[i])) ? i : n;
+}
+
+/**
+ * Same as lowerBound(), but the loop does not depend on the result of the
+ * comparisons. The search range is halved on every iteration, and its base
+ * is selected using a conditional expression, which compiles into a
+ * conditional move on processors which have one (e.g. x86, ARM). This avoids
+ * the branch mispredictions of lowerBound() on lookups of random values, at
+ * the cost of always performing `ceil(log2(n)) + 1` comparisons. On 8-bit AVR
+ * processors, which have no conditional move, it is about the same as
+ * lowerBound().
+ *
+ * Complexity: O(log(n))
+ *
+ * @tparam T type of data
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename S = uint16_t>
+S lowerBoundBranchless(
+    const T data[], S n,
+    const typename internal::TypeIdentity<T>::type& value) {
+  auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
+  return lowerBoundBranchless(data, n, value, lessThan);
+}
+
+/**
+ * Same as the 3-argument lowerBoundBranchless() with the addition of a
+ * `lessThan` lambda expression or function, which must be the same as the one
+ * used to sort data[].
+ *
+ * @tparam T type of data
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename F, typename S = uint16_t>
+S lowerBoundBranchless(
+    const T data[], S n, const typename internal::TypeIdentity<T>::type& value,
+    F&& lessThan) {
+  if (n == 0) return 0;
+
+  // The result is always in [base, base + n].
+  const T* base = data;
+  while (n > 1) {
+    S half = n / 2;
+    base = lessThan(base[half], value) ? base + half : base;
+    n -= half;
+  }
+  return (S) (base - data) + lessThan(*base, value);
+}
+
+/**
+ * Same as upperBound(), but branchless like lowerBoundBranchless().
+ *
+ * Complexity: O(log(n))
+ *
+ * @tparam T type of data
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename S = uint16_t>
+S upperBoundBranchless(
+    const T data[], S n,
+    const typename internal::TypeIdentity<T>::type& value) {
+  auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
+  return upperBoundBranchless(data, n, value, lessThan);
+}
+
+/**
+ * Same as the 3-argument upperBoundBranchless() with the addition of a
+ * `lessThan` lambda expression or function, which must be the same as the one
+ * used to sort data[].
+ *
+ * @tparam T type of data
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename F, typename S = uint16_t>
+S upperBoundBranchless(
+    const T data[], S n, const typename internal::TypeIdentity<T>::type& value,
+    F&& lessThan) {
+  if (n == 0) return 0;
+
+  // The result is always in [base, base + n].
+  const T* base = data;
+  while (n > 1) {
+    S half = n / 2;
+    base = lessThan(value, base[half]) ? base : base + half;
+    n -= half;
+  }
+  return (S) (base - data) + ! lessThan(value, *base);
+}
+
+}
+
+#endif
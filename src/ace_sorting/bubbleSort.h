@@ -50,14 +50,15 @@ namespace ace_sorting {
  * Average complexity: O(n^2)
  *
  * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
  */
 #if ACE_SORTING_DIRECT_BUBBLE_SORT
-template <typename T>
-void bubbleSort(T data[], uint16_t n) {
+template <typename T, typename S = uint16_t>
+void bubbleSort(T data[], S n) {
   bool swapped;
   do {
     swapped = false;
-    for (uint16_t i = 1; i < n; i++) {
+    for (S i = 1; i < n; i++) {
       if (data[i] < data[i - 1]) {
         swap(data[i - 1], data[i]);
         swapped = true;
@@ -66,8 +67,8 @@ void bubbleSort(T data[], uint16_t n) {
   } while (swapped);
 }
 #else
-template <typename T>
-void bubbleSort(T data[], uint16_t n) {
+template <typename T, typename S = uint16_t>
+void bubbleSort(T data[], S n) {
   auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
   bubbleSort(data, n, lessThan);
 }
@@ -79,13 +80,14 @@ void bubbleSort(T data[], uint16_t n) {
  *
  * @tparam T type of data to sort
  * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
  */
-template <typename T, typename F>
-void bubbleSort(T data[], uint16_t n, F&& lessThan) {
+template <typename T, typename F, typename S = uint16_t>
+void bubbleSort(T data[], S n, F&& lessThan) {
   bool swapped;
   do {
     swapped = false;
-    for (uint16_t i = 1; i < n; i++) {
+    for (S i = 1; i < n; i++) {
       if (lessThan(data[i], data[i - 1])) {
         swap(data[i - 1], data[i]);
         swapped = true;
@@ -49,26 +49,29 @@ namespace ace_sorting {
  * Comb sort using a gap factor of 1.3 (successive gap is multiplied by
  * 10 / 13). On 8-bit processors where the `int` type is 2 bytes, the
  * multiplication of `n` by 10 can overflow the 16-bit integer. So the largest
- * `n` that this function can support is 65536 / 10 or 6553.
+ * `n` that this function can support is 65536 / 10 or 6553. Larger arrays can
+ * be sorted by passing `n` as a `uint32_t`, which raises the limit to
+ * 4294967295 / 10.
  *
  * Average complexity: O(n^2 / 2^p).
  * See https://en.wikipedia.org/wiki/Comb_sort
  *
  * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
  */
 #if ACE_SORTING_DIRECT_COMB_SORT
-template <typename T>
-void combSort13(T data[], uint16_t n) {
+template <typename T, typename S = uint16_t>
+void combSort13(T data[], S n) {
   bool swapped = true;
 
-  uint16_t gap = n;
+  S gap = n;
   while (swapped || gap > 1) {
     gap = gap * 10 / 13;
     if (gap == 0) gap = 1;
     swapped = false;
 
-    uint16_t i;
-    uint16_t j;
+    S i;
+    S j;
     for (i = 0, j = gap; j < n; i++, j++) {
       if (data[j] < data[i]) {
         swap(data[i], data[j]);
@@ -78,8 +81,8 @@ void combSort13(T data[], uint16_t n) {
   }
 }
 #else
-template <typename T>
-void combSort13(T data[], uint16_t n) {
+template <typename T, typename S = uint16_t>
+void combSort13(T data[], S n) {
   // This lambda expression does not perform any captures, so the compiler will
   // optimize and inline the less-than expression.
   auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
@@ -93,19 +96,20 @@ void combSort13(T data[], uint16_t n) {
  *
  * @tparam T type of data to sort
  * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
  */
-template <typename T, typename F>
-void combSort13(T data[], uint16_t n, F&& lessThan) {
+template <typename T, typename F, typename S = uint16_t>
+void combSort13(T data[], S n, F&& lessThan) {
   bool swapped = true;
 
-  uint16_t gap = n;
+  S gap = n;
   while (swapped || gap > 1) {
     gap = gap * 10 / 13;
     if (gap == 0) gap = 1;
     swapped = false;
 
-    uint16_t i;
-    uint16_t j;
+    S i;
+    S j;
     for (i = 0, j = gap; j < n; i++, j++) {
       if (lessThan(data[j], data[i])) {
         swap(data[i], data[j]);
@@ -128,13 +132,14 @@ void combSort13(T data[], uint16_t n, F&& lessThan) {
  * https://rosettacode.org/wiki/Sorting_algorithms/Comb_sort.
  *
  * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
  */
 #if ACE_SORTING_DIRECT_COMB_SORT
-template <typename T>
-void combSort13m(T data[], uint16_t n) {
+template <typename T, typename S = uint16_t>
+void combSort13m(T data[], S n) {
   bool swapped = true;
 
-  uint16_t gap = n;
+  S gap = n;
   while (swapped || gap > 1) {
     gap = gap * 10 / 13;
     if (gap == 9 || gap == 10) {
@@ -144,8 +149,8 @@ void combSort13m(T data[], uint16_t n) {
     }
     swapped = false;
 
-    uint16_t i;
-    uint16_t j;
+    S i;
+    S j;
     for (i = 0, j = gap; j < n; i++, j++) {
       if (data[j] < data[i]) {
         swap(data[i], data[j]);
@@ -155,8 +160,8 @@ void combSort13m(T data[], uint16_t n) {
   }
 }
 #else
-template <typename T>
-void combSort13m(T data[], uint16_t n) {
+template <typename T, typename S = uint16_t>
+void combSort13m(T data[], S n) {
   // This lambda expression does not perform any captures, so the compiler will
   // optimize and inline the less-than expression.
   auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
@@ -170,12 +175,13 @@ void combSort13m(T data[], uint16_t n) {
  *
  * @tparam T type of data to sort
  * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
  */
-template <typename T, typename F>
-void combSort13m(T data[], uint16_t n, F&& lessThan) {
+template <typename T, typename F, typename S = uint16_t>
+void combSort13m(T data[], S n, F&& lessThan) {
   bool swapped = true;
 
-  uint16_t gap = n;
+  S gap = n;
   while (swapped || gap > 1) {
     gap = gap * 10 / 13;
     if (gap == 9 || gap == 10) {
@@ -185,8 +191,8 @@ void combSort13m(T data[], uint16_t n, F&& lessThan) {
     }
     swapped = false;
 
-    uint16_t i;
-    uint16_t j;
+    S i;
+    S j;
     for (i = 0, j = gap; j < n; i++, j++) {
       if (lessThan(data[j], data[i])) {
         swap(data[i], data[j]);
@@ -202,7 +208,7 @@ void combSort13m(T data[], uint16_t n, F&& lessThan) {
  * Comb sort using a gap factor of 4/3=1.33 (successive gap is multiplied by 3
  * / 4). The multiplication by 3 can overflow the 2-byte `int` type on 8-bit
  * processors, so the largest `n` supported by this function is 65535 / 3 or
- * 21845.
+ * 21845. Passing `n` as a `uint32_t` raises the limit to 4294967295 / 3.
  *
  * This gap ratio seemed appealing because the division by 4 will be optimized
  * by the compiler into a right shift of 2 bits, so this algorithm does not
@@ -220,20 +226,21 @@ void combSort13m(T data[], uint16_t n, F&& lessThan) {
  * See https://en.wikipedia.org/wiki/Comb_sort
  *
  * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
  */
 #if ACE_SORTING_DIRECT_COMB_SORT
-template <typename T>
-void combSort133(T data[], uint16_t n) {
+template <typename T, typename S = uint16_t>
+void combSort133(T data[], S n) {
   bool swapped = true;
 
-  uint16_t gap = n;
+  S gap = n;
   while (swapped || gap > 1) {
     gap = gap * 3 / 4;
     if (gap == 0) gap = 1;
     swapped = false;
 
-    uint16_t i;
-    uint16_t j;
+    S i;
+    S j;
     for (i = 0, j = gap; j < n; i++, j++) {
       if (data[j] < data[i]) {
         swap(data[i], data[j]);
@@ -243,8 +250,8 @@ void combSort133(T data[], uint16_t n) {
   }
 }
 #else
-template <typename T>
-void combSort133(T data[], uint16_t n) {
+template <typename T, typename S = uint16_t>
+void combSort133(T data[], S n) {
   // This lambda expression does not perform any captures, so the compiler will
   // optimize and inline the less-than expression.
   auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
@@ -258,19 +265,20 @@ void combSort133(T data[], uint16_t n) {
  *
  * @tparam T type of data to sort
  * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
  */
-template <typename T, typename F>
-void combSort133(T data[], uint16_t n, F&& lessThan) {
+template <typename T, typename F, typename S = uint16_t>
+void combSort133(T data[], S n, F&& lessThan) {
   bool swapped = true;
 
-  uint16_t gap = n;
+  S gap = n;
   while (swapped || gap > 1) {
     gap = gap * 3 / 4;
     if (gap == 0) gap = 1;
     swapped = false;
 
-    uint16_t i;
-    uint16_t j;
+    S i;
+    S j;
     for (i = 0, j = gap; j < n; i++, j++) {
       if (lessThan(data[j], data[i])) {
         swap(data[i], data[j]);
@@ -292,13 +300,14 @@ void combSort133(T data[], uint16_t n, F&& lessThan) {
  * See https://en.wikipedia.org/wiki/Comb_sort
  *
  * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
  */
 #if ACE_SORTING_DIRECT_COMB_SORT
-template <typename T>
-void combSort133m(T data[], uint16_t n) {
+template <typename T, typename S = uint16_t>
+void combSort133m(T data[], S n) {
   bool swapped = true;
 
-  uint16_t gap = n;
+  S gap = n;
   while (swapped || gap > 1) {
     gap = gap * 3 / 4;
     if (gap == 9 || gap == 10) {
@@ -308,8 +317,8 @@ void combSort133m(T data[], uint16_t n) {
     }
     swapped = false;
 
-    uint16_t i;
-    uint16_t j;
+    S i;
+    S j;
     for (i = 0, j = gap; j < n; i++, j++) {
       if (data[j] < data[i]) {
         swap(data[i], data[j]);
@@ -319,8 +328,8 @@ void combSort133m(T data[], uint16_t n) {
   }
 }
 #else
-template <typename T>
-void combSort133m(T data[], uint16_t n) {
+template <typename T, typename S = uint16_t>
+void combSort133m(T data[], S n) {
   // This lambda expression does not perform any captures, so the compiler will
   // optimize and inline the less-than expression.
   auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
@@ -334,12 +343,13 @@ void combSort133m(T data[], uint16_t n) {
  *
  * @tparam T type of data to sort
  * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
  */
-template <typename T, typename F>
-void combSort133m(T data[], uint16_t n, F&& lessThan) {
+template <typename T, typename F, typename S = uint16_t>
+void combSort133m(T data[], S n, F&& lessThan) {
   bool swapped = true;
 
-  uint16_t gap = n;
+  S gap = n;
   while (swapped || gap > 1) {
     gap = gap * 3 / 4;
     if (gap == 9 || gap == 10) {
@@ -349,8 +359,8 @@ void combSort133m(T data[], uint16_t n, F&& lessThan) {
     }
     swapped = false;
 
-    uint16_t i;
-    uint16_t j;
+    S i;
+    S j;
     for (i = 0, j = gap; j < n; i++, j++) {
       if (lessThan(data[j], data[i])) {
         swap(data[i], data[j]);
@@ -0,0 +1,132 @@
+/*
+MIT License
+
+Copyright (c) 2021 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file countingSort.h
+ *
+ * Counting sort for integer keys with a small range, using a table of counters
+ * supplied by the caller.
+ * See https://en.wikipedia.org/wiki/Counting_sort
+ */
+
+#ifndef ACE_SORTING_COUNTING_SORT_H
+#define ACE_SORTING_COUNTING_SORT_H
+
+#include <stdint.h> // uint16_t
+
+namespace ace_sorting {
+
+/**
+ * Counting sort of non-negative integers in the range of [0, maxKey]. Not a
+ * comparison sort: the number of occurrences of each value is tallied in
+ * `counts`, then `data` is overwritten with each value repeated by its count.
+ * The caller must supply a `counts` array of at least `maxKey+1` elements.
+ * Intended for data whose range is small compared to `n`, for example
+ * `uint8_t` values, bounded enums, or 10-bit ADC readings.
+ *
+ * Complexity: O(n + maxKey)
+ * Stable sort: Not applicable, since equal values are indistinguishable.
+ *
+ * @tparam T type of data to sort, an integer type
+ * @tparam K type of the `maxKey`, an integer type
+ * @tparam C type of the `counts`, an integer type large enough to hold `n`
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename K, typename C, typename S = uint16_t>
+void countingSort(T data[], S n, K maxKey, C counts[]) {
+  if (n <= 1) return;
+
+  // Loops over the keys terminate using an explicit check so that `maxKey`
+  // can be the largest value of its type (e.g. 255 for a uint8_t).
+  for (K k = 0; ; k++) {
+    counts[k] = 0;
+    if (k == maxKey) break;
+  }
+  for (S i = 0; i < n; i++) {
+    counts[data[i]]++;
+  }
+
+  S i = 0;
+  for (K k = 0; ; k++) {
+    for (S count = counts[k]; count > 0; count--) {
+      data[i++] = (T) k;
+    }
+    if (k == maxKey) break;
+  }
+}
+
+/**
+ * Same as the 4-argument countingSort() but sorts elements of any type `T`
+ * using the integer key in the range of [0, maxKey] returned by the `keyOf`
+ * lambda expression or function. The elements are scattered stably into the
+ * `buffer`, which must hold at least `n` elements, then copied back into
+ * `data`. The sort is stable, so records can be sorted by multiple keys using
+ * multiple passes.
+ *
+ * Like radixSort(), the last argument is not a `lessThan` predicate. To sort
+ * in reverse order, return `maxKey - key`.
+ *
+ * Complexity: O(n + maxKey)
+ * Stable sort: Yes
+ *
+ * @tparam T type of data to sort
+ * @tparam K type of the `maxKey`, an integer type
+ * @tparam C type of the `counts`, an integer type large enough to hold `n`
+ * @tparam F type of lambda expression or function that returns the key of an
+ *    element
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename K, typename C, typename F,
+    typename S = uint16_t>
+void countingSort(
+    T data[], S n, K maxKey, C counts[], T buffer[], F&& keyOf) {
+  if (n <= 1) return;
+
+  for (K k = 0; ; k++) {
+    counts[k] = 0;
+    if (k == maxKey) break;
+  }
+  for (S i = 0; i < n; i++) {
+    counts[keyOf(data[i])]++;
+  }
+
+  // Convert the counts into the starting position of each key.
+  S sum = 0;
+  for (K k = 0; ; k++) {
+    S count = counts[k];
+    counts[k] = sum;
+    sum += count;
+    if (k == maxKey) break;
+  }
+
+  for (S i = 0; i < n; i++) {
+    buffer[counts[keyOf(data[i])]++] = data[i];
+  }
+  for (S i = 0; i < n; i++) {
+    data[i] = buffer[i];
+  }
+}
+
+}
+
+#endif
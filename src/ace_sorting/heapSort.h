@@ -0,0 +1,140 @@
+/*
+MIT License
+
+Copyright (c) 2021 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file heapSort.h
+ *
+ * Heap sort.
+ * See https://en.wikipedia.org/wiki/Heapsort
+ */
+
+#ifndef ACE_SORTING_HEAP_SORT_H
+#define ACE_SORTING_HEAP_SORT_H
+
+#include "swap.h"
+
+#if ! defined(ACE_SORTING_DIRECT_HEAP_SORT)
+  /**
+   * If set to 1, use the direct inlined implementation of the 2-argument
+   * heapSort(). Otherwise, use the 3-argument heapSort() to implement
+   * 2-argument heapSort(). For heapSort(), the compiler will optimize both
+   * versions to be identical.
+   */
+  #define ACE_SORTING_DIRECT_HEAP_SORT 0
+#endif
+
+namespace ace_sorting {
+
+/**
+ * Heap sort. The heap construction phase and the extraction phase are merged
+ * into a single loop so that the sift-down code appears only once, which saves
+ * flash memory. Does not use recursion, so the stack usage is constant.
+ *
+ * Average complexity: O(n log(n))
+ * Worst complexity: O(n log(n))
+ * See https://en.wikipedia.org/wiki/Heapsort
+ *
+ * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+#if ACE_SORTING_DIRECT_HEAP_SORT
+template <typename T, typename S = uint16_t>
+void heapSort(T data[], S n) {
+  S start = n / 2;
+  S end = n;
+  while (end > 1) {
+    if (start > 0) {
+      // Heap construction: sift down each parent node, from the last one.
+      start--;
+    } else {
+      // Extraction: move the largest element to the end of the array, then
+      // restore the heap in the remaining elements.
+      end--;
+      swap(data[0], data[end]);
+    }
+
+    // Sift down data[start] until it is larger than both of its children.
+    // The loop condition guarantees that (2 * root + 1) cannot overflow S.
+    S root = start;
+    T temp = data[root];
+    while (root < end / 2) {
+      S child = 2 * root + 1;
+      if (child + 1 < end && data[child] < data[child + 1]) child++;
+      if (! (temp < data[child])) break;
+      data[root] = data[child];
+      root = child;
+    }
+    data[root] = temp;
+  }
+}
+#else
+template <typename T, typename S = uint16_t>
+void heapSort(T data[], S n) {
+  // This lambda expression does not perform any captures, so the compiler will
+  // optimize and inline the less-than expression.
+  auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
+  heapSort(data, n, lessThan);
+}
+#endif
+
+/**
+ * Same as the 2-argument heapSort() with the addition of a `lessThan` lambda
+ * expression or function.
+ *
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename F, typename S = uint16_t>
+void heapSort(T data[], S n, F&& lessThan) {
+  S start = n / 2;
+  S end = n;
+  while (end > 1) {
+    if (start > 0) {
+      // Heap construction: sift down each parent node, from the last one.
+      start--;
+    } else {
+      // Extraction: move the largest element to the end of the array, then
+      // restore the heap in the remaining elements.
+      end--;
+      swap(data[0], data[end]);
+    }
+
+    // Sift down data[start] until it is larger than both of its children.
+    // The loop condition guarantees that (2 * root + 1) cannot overflow S.
+    S root = start;
+    T temp = data[root];
+    while (root < end / 2) {
+      S child = 2 * root + 1;
+      if (child + 1 < end && lessThan(data[child], data[child + 1])) child++;
+      if (! lessThan(temp, data[child])) break;
+      data[root] = data[child];
+      root = child;
+    }
+    data[root] = temp;
+  }
+}
+
+}
+
+#endif
@@ -50,15 +50,16 @@ namespace ace_sorting {
  * See https://en.wikipedia.org/wiki/Insertion_sort
  *
  * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
  */
 #if ACE_SORTING_DIRECT_INSERTION_SORT
-template <typename T>
-void insertionSort(T data[], uint16_t n) {
-  for (uint16_t i = 1; i < n; i++) {
+template <typename T, typename S = uint16_t>
+void insertionSort(T data[], S n) {
+  for (S i = 1; i < n; i++) {
     T temp = data[i];
 
     // Shift one slot to the right.
-    uint16_t j;
+    S j;
     for (j = i; j > 0; j--) {
       if (data[j - 1] <= temp) break;
       data[j] = data[j - 1];
@@ -72,8 +73,8 @@ void insertionSort(T data[], uint16_t n) {
   }
 }
 #else
-template <typename T>
-void insertionSort(T data[], uint16_t n) {
+template <typename T, typename S = uint16_t>
+void insertionSort(T data[], S n) {
   // This lambda expression does not perform any captures, so the compiler will
   // optimize and inline the less-than expression.
   auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
@@ -87,14 +88,15 @@ void insertionSort(T data[], uint16_t n) {
  *
  * @tparam T type of data to sort
  * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
  */
-template <typename T, typename F>
-void insertionSort(T data[], uint16_t n, F&& lessThan) {
-  for (uint16_t i = 1; i < n; i++) {
+template <typename T, typename F, typename S = uint16_t>
+void insertionSort(T data[], S n, F&& lessThan) {
+  for (S i = 1; i < n; i++) {
     T temp = data[i];
 
     // Shift one slot to the right.
-    uint16_t j;
+    S j;
     for (j = i; j > 0; j--) {
       // The following is equivalent to: (data[j - 1] <= temp)
       if (! lessThan(temp, data[j - 1])) break;
@@ -0,0 +1,176 @@
+/*
+MIT License
+
+Copyright (c) 2021 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file introSort.h
+ *
+ * Introsort, a hybrid of Quick Sort, Heap Sort and Insertion Sort.
+ * See https://en.wikipedia.org/wiki/Introsort
+ */
+
+#ifndef ACE_SORTING_INTRO_SORT_H
+#define ACE_SORTING_INTRO_SORT_H
+
+#include "swap.h"
+#include "insertionSort.h"
+#include "heapSort.h"
+
+#if ! defined(ACE_SORTING_INTRO_SORT_THRESHOLD)
+  /**
+   * Partitions smaller than or equal to this size are sorted using
+   * insertionSort() instead of being partitioned further.
+   */
+  #define ACE_SORTING_INTRO_SORT_THRESHOLD 16
+#endif
+
+namespace ace_sorting {
+
+namespace internal {
+
+/**
+ * Return the maximum partitioning depth allowed by introSort() before it
+ * switches to the fallback algorithm, 2*floor(log2(n)).
+ *
+ * @tparam S type of the index into data[]
+ */
+template <typename S>
+uint8_t introSortDepthLimit(S n) {
+  uint8_t depthLimit = 0;
+  for (; n > 1; n >>= 1) {
+    depthLimit += 2;
+  }
+  return depthLimit;
+}
+
+/**
+ * Recursive part of introSort(). Partitions using the same median-of-3 pivot
+ * as quickSortMedianSwapped(). The smaller partition is handled through
+ * recursion and the larger partition is handled by the loop, so the recursion
+ * depth can never exceed log2(n), even before `depthLimit` is reached. When
+ * `depthLimit` drops to 0, the remaining partition is sorted using
+ * heapSort() which does not recurse.
+ *
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[]
+ */
+template <typename T, typename F, typename S>
+void introSortRecursive(T data[], S n, uint8_t depthLimit, F&& lessThan) {
+  while (n > ACE_SORTING_INTRO_SORT_THRESHOLD) {
+    if (depthLimit == 0) {
+      heapSort(data, n, lessThan);
+      return;
+    }
+    depthLimit--;
+
+    // Select the median of data[low], data[mid], and data[high] as the
+    // estimate of the ideal pivot. In the process, the (low, mid, high) become
+    // sorted.
+    S mid = n / 2;
+    T pivot = data[mid];
+    if (lessThan(data[n - 1], data[0])) {
+      swap(data[0], data[n - 1]);
+    }
+    if (lessThan(pivot, data[0])) {
+      swap(data[0], data[mid]);
+    } else if (lessThan(data[n - 1], pivot)) {
+      swap(data[mid], data[n - 1]);
+    }
+    pivot = data[mid];
+
+    // We can skip the low and high because they are already sorted.
+    T* left = data + 1;
+    T* right = data + n - 2;
+
+    while (left <= right) {
+      if (lessThan(*left, pivot)) {
+        left++;
+      } else if (lessThan(pivot, *right)) {
+        right--;
+      } else {
+        swap(*left, *right);
+        left++;
+        right--;
+      }
+    }
+
+    S nLeft = right - data + 1;
+    S nRight = data + n - left;
+    if (nLeft < nRight) {
+      introSortRecursive(data, nLeft, depthLimit, lessThan);
+      data = left;
+      n = nRight;
+    } else {
+      introSortRecursive(left, nRight, depthLimit, lessThan);
+      n = nLeft;
+    }
+  }
+
+  insertionSort(data, n, lessThan);
+}
+
+}
+
+/**
+ * Introsort. Uses Quick Sort with a median-of-3 pivot (same as
+ * quickSortMedianSwapped()) until the partitioning depth exceeds
+ * 2*log2(n), then switches to heapSort() for the remaining partition.
+ * Partitions smaller than ACE_SORTING_INTRO_SORT_THRESHOLD are sorted with
+ * insertionSort().
+ *
+ * The recursion only follows the smaller partition, so the stack usage is
+ * bounded by `O(log(N))` regardless of the input data.
+ *
+ * Average complexity: O(n log(n))
+ * Worst complexity: O(n log(n))
+ *
+ * The 2-argument version always delegates to the 3-argument version because
+ * the recursion happens in an internal function, so there is no
+ * ACE_SORTING_DIRECT_INTRO_SORT macro.
+ *
+ * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename S = uint16_t>
+void introSort(T data[], S n) {
+  auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
+  introSort(data, n, lessThan);
+}
+
+/**
+ * Same as the 2-argument introSort() with the addition of a `lessThan` lambda
+ * expression or function.
+ *
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename F, typename S = uint16_t>
+void introSort(T data[], S n, F&& lessThan) {
+  internal::introSortRecursive(
+      data, n, internal::introSortDepthLimit(n), lessThan);
+}
+
+}
+
+#endif
@@ -0,0 +1,319 @@
+/*
+MIT License
+
+Copyright (c) 2021 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file kWayMerge.h
+ *
+ * Merge of K sorted arrays into a single sorted output, using a tournament
+ * tree of losers. See https://en.wikipedia.org/wiki/K-way_merge_algorithm
+ */
+
+#ifndef ACE_SORTING_K_WAY_MERGE_H
+#define ACE_SORTING_K_WAY_MERGE_H
+
+#include <stdint.h> // uint8_t, uint16_t
+#include "typeIdentity.h"
+
+namespace ace_sorting {
+
+namespace internal {
+
+/**
+ * Merge the sorted data1[] and data2[], passing each element to `sink` in
+ * sorted order. Equal elements are taken from data1[] first, so the merge is
+ * stable.
+ *
+ * @tparam T type of data
+ * @tparam S type of the index into data1[] and data2[]
+ * @tparam C type of lambda expression or function which accepts a `const T&`
+ * @tparam F type of lambda expression or function that returns true if a < b
+ */
+template <typename T, typename S, typename C, typename F>
+void mergeToSink(
+    const T data1[], S n1, const T data2[], S n2, C&& sink, F&& lessThan) {
+  S i = 0;
+  S j = 0;
+  while (i < n1 && j < n2) {
+    if (lessThan(data2[j], data1[i])) {
+      sink(data2[j++]);
+    } else {
+      sink(data1[i++]);
+    }
+  }
+  while (i < n1) sink(data1[i++]);
+  while (j < n2) sink(data2[j++]);
+}
+
+/**
+ * A tournament tree of losers over K sorted inputs. The internal node
+ * mTree[t], for t in [1, K), holds the input which lost the match at that
+ * node, and mTree[0] holds the overall winner, whose next element is the
+ * smallest of all the inputs. The leaves are implicit: node t >= K is the
+ * leaf of input t - K, so the parent of input i is (i + K) / 2. After the
+ * winner is removed, only the matches on the path from its leaf to the root
+ * are replayed, against the losers stored on that path. That costs
+ * `ceil(log2(K))` calls to `lessThan` per element, compared to about
+ * `2 * log2(K)` for a binary heap, which must compare both children at each
+ * level.
+ *
+ * An exhausted input loses every match. Ties are won by the input with the
+ * lower index, so the merge is stable. The result of each match is applied
+ * using conditional expressions instead of branches, so that the only
+ * unpredictable branch is the comparison inside `lessThan`, if any.
+ *
+ * @tparam K number of inputs, at least 2
+ * @tparam T type of data
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into each input
+ */
+template <uint8_t K, typename T, typename F, typename S>
+class LoserTree {
+  public:
+    LoserTree(const T* const inputs[], const S sizes[], F& lessThan) :
+        mLessThan(lessThan)
+    {
+      for (uint8_t i = 0; i < K; i++) {
+        mCurrent[i] = inputs[i];
+        mEnd[i] = inputs[i] + sizes[i];
+      }
+      mTree[0] = build(1);
+    }
+
+    /** Return true if all the inputs have been consumed. */
+    bool isEmpty() const { return isExhausted(mTree[0]); }
+
+    /** Remove and return the smallest element. Must not be empty. */
+    const T& pop() {
+      uint8_t winner = mTree[0];
+      const T& value = *mCurrent[winner]++;
+      replay(winner);
+      return value;
+    }
+
+  private:
+    bool isExhausted(uint8_t i) const { return mCurrent[i] == mEnd[i]; }
+
+    /**
+     * Return true if input i wins the match against input j, i.e. its next
+     * element comes first in the output. The elements are passed to
+     * `lessThan` in the order of their inputs, so that the tie is won by the
+     * lower index with a single call, and without a branch on the indexes.
+     */
+    bool wins(uint8_t i, uint8_t j) const {
+      if (isExhausted(i)) return false;
+      if (isExhausted(j)) return true;
+
+      bool isLower = i < j;
+      const T* lower = isLower ? mCurrent[i] : mCurrent[j];
+      const T* upper = isLower ? mCurrent[j] : mCurrent[i];
+      return isLower == ! mLessThan(*upper, *lower);
+    }
+
+    /**
+     * Play the matches of the subtree at node t, storing the losers, and
+     * return its winner. The recursion depth is `ceil(log2(K))`.
+     */
+    uint8_t build(uint16_t t) {
+      if (t >= K) return t - K;
+
+      uint8_t left = build(2 * t);
+      uint8_t right = build(2 * t + 1);
+      bool leftWins = wins(left, right);
+      mTree[t] = leftWins ? right : left;
+      return leftWins ? left : right;
+    }
+
+    /**
+     * Replay the matches from the leaf of input s to the root. The loser of
+     * each match stays at the node, and the winner moves up.
+     */
+    void replay(uint8_t s) {
+      for (uint16_t t = ((uint16_t) s + K) / 2; t > 0; t /= 2) {
+        uint8_t other = mTree[t];
+        bool otherWins = wins(other, s);
+        mTree[t] = otherWins ? s : other;
+        s = otherWins ? other : s;
+      }
+      mTree[0] = s;
+    }
+
+    F& mLessThan;
+    const T* mCurrent[K];
+    const T* mEnd[K];
+    uint8_t mTree[K];
+};
+
+/**
+ * Merge the K inputs into `sink`. The case K == 1 is a copy, and K == 2 uses
+ * mergeToSink(), which needs neither the tree nor the cursors.
+ *
+ * @tparam K number of inputs
+ * @tparam T type of data
+ * @tparam S type of the index into each input
+ * @tparam C type of lambda expression or function which accepts a `const T&`
+ * @tparam F type of lambda expression or function that returns true if a < b
+ */
+template <uint8_t K, typename T, typename S, typename C, typename F>
+void kWayMergeToSink(
+    const T* const inputs[], const S sizes[], C&& sink, F&& lessThan) {
+  if (K == 1) {
+    for (S i = 0; i < sizes[0]; i++) {
+      sink(inputs[0][i]);
+    }
+    return;
+  }
+  if (K == 2) {
+    mergeToSink(inputs[0], sizes[0], inputs[1], sizes[1], sink, lessThan);
+    return;
+  }
+
+  LoserTree<K, T, F, S> tree(
+      inputs, sizes, lessThan);
+  while (! tree.isEmpty()) {
+    sink(tree.pop());
+  }
+}
+
+}
+
+/**
+ * Merge the sorted arrays data1[] and data2[] into output[], which must hold
+ * `n1 + n2` elements and must not overlap the inputs. Equal elements are
+ * taken from data1[] first, so the merge is stable.
+ *
+ * Complexity: O(n1 + n2)
+ *
+ * @tparam T type of data
+ * @tparam S type of the index into data1[] and data2[], usually inferred from
+ *    `n1`
+ */
+template <typename T, typename S = uint16_t>
+void merge(
+    const T data1[], S n1,
+    const T data2[], typename internal::TypeIdentity<S>::type n2,
+    T output[]) {
+  auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
+  merge(data1, n1, data2, n2, output, lessThan);
+}
+
+/**
+ * Same as the 5-argument merge() with the addition of a `lessThan` lambda
+ * expression or function, which must be the same as the one used to sort
+ * the inputs.
+ *
+ * @tparam T type of data
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data1[] and data2[], usually inferred from
+ *    `n1`
+ */
+template <typename T, typename F, typename S = uint16_t>
+void merge(
+    const T data1[], S n1,
+    const T data2[], typename internal::TypeIdentity<S>::type n2,
+    T output[], F&& lessThan) {
+  internal::mergeToSink(
+      data1, n1, data2, n2,
+      [&output](const T& x) { *output++ = x; },
+      lessThan);
+}
+
+/**
+ * Merge the K sorted arrays inputs[i] of sizes[i] elements into output[],
+ * which must hold the sum of the sizes, and must not overlap the inputs. K is
+ * given explicitly, like sortFixed(), e.g. `kWayMerge<4>(inputs, sizes,
+ * output)`. Equal elements are taken from the input with the lowest index
+ * first, so the merge is stable.
+ *
+ * Uses a tournament tree of losers, which needs `ceil(log2(K))` comparisons
+ * per element. Unlike sorting the concatenation of the inputs again, it
+ * takes advantage of the order of the inputs. The tree and the cursors are
+ * stored on the stack, using `K * (1 + 2 * sizeof(T*))` bytes.
+ *
+ * Complexity: O(N log(K)), where N is the total number of elements
+ *
+ * @tparam K number of inputs, 1 to 255
+ * @tparam T type of data
+ * @tparam S type of the index into each input, usually inferred from `sizes`
+ */
+template <uint8_t K, typename T, typename S = uint16_t>
+void kWayMerge(const T* const inputs[], const S sizes[], T output[]) {
+  auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
+  kWayMerge<K>(inputs, sizes, output, lessThan);
+}
+
+/**
+ * Same as the 3-argument kWayMerge() with the addition of a `lessThan` lambda
+ * expression or function, which must be the same as the one used to sort the
+ * inputs.
+ *
+ * @tparam K number of inputs, 1 to 255
+ * @tparam T type of data
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into each input, usually inferred from `sizes`
+ */
+template <uint8_t K, typename T, typename F, typename S = uint16_t>
+void kWayMerge(
+    const T* const inputs[], const S sizes[], T output[], F&& lessThan) {
+  internal::kWayMergeToSink<K>(
+      inputs, sizes,
+      [&output](const T& x) { *output++ = x; },
+      lessThan);
+}
+
+/**
+ * Same as the 3-argument kWayMerge(), but each element is passed to `sink`
+ * in sorted order instead of being copied into an output array. For example,
+ * the merged stream can be written to the serial port or to a file, without
+ * the ram for the whole output.
+ *
+ * @tparam K number of inputs, 1 to 255
+ * @tparam T type of data
+ * @tparam C type of lambda expression or function which accepts a `const T&`
+ * @tparam S type of the index into each input, usually inferred from `sizes`
+ */
+template <uint8_t K, typename T, typename C, typename S = uint16_t>
+void kWayMergeSink(const T* const inputs[], const S sizes[], C&& sink) {
+  auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
+  kWayMergeSink<K>(inputs, sizes, sink, lessThan);
+}
+
+/**
+ * Same as the 3-argument kWayMergeSink() with the addition of a `lessThan`
+ * lambda expression or function, which must be the same as the one used to
+ * sort the inputs.
+ *
+ * @tparam K number of inputs, 1 to 255
+ * @tparam T type of data
+ * @tparam C type of lambda expression or function which accepts a `const T&`
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into each input, usually inferred from `sizes`
+ */
+template <uint8_t K, typename T, typename C, typename F, typename S = uint16_t>
+void kWayMergeSink(
+    const T* const inputs[], const S sizes[], C&& sink, F&& lessThan) {
+  internal::kWayMergeToSink<K>(inputs, sizes, sink, lessThan);
+}
+
+}
+
+#endif
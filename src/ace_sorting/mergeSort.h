@@ -0,0 +1,138 @@
+/*
+MIT License
+
+Copyright (c) 2021 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file mergeSort.h
+ *
+ * Merge sort, using a scratch buffer supplied by the caller.
+ * See https://en.wikipedia.org/wiki/Merge_sort
+ */
+
+#ifndef ACE_SORTING_MERGE_SORT_H
+#define ACE_SORTING_MERGE_SORT_H
+
+#include "insertionSort.h"
+
+#if ! defined(ACE_SORTING_MERGE_SORT_THRESHOLD)
+  /**
+   * Sub-arrays smaller than or equal to this size are sorted using
+   * insertionSort(), which is also a stable sort, instead of being split
+   * further. Must be at least 1.
+   */
+  #define ACE_SORTING_MERGE_SORT_THRESHOLD 8
+#endif
+
+namespace ace_sorting {
+
+namespace internal {
+
+/**
+ * Recursive part of mergeSort(). Sorts the left and right halves, then copies
+ * the left half into `buffer` and merges it with the right half back into
+ * `data`. The remaining elements of the right half are already in their final
+ * position, so only the left half needs to be copied. When the 2 halves are
+ * equal, the element from the left half is taken first, which makes the sort
+ * stable.
+ *
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[]
+ */
+template <typename T, typename F, typename S>
+void mergeSortRecursive(T data[], S n, T buffer[], F&& lessThan) {
+  if (n <= ACE_SORTING_MERGE_SORT_THRESHOLD) {
+    insertionSort(data, n, lessThan);
+    return;
+  }
+
+  S mid = n / 2;
+  mergeSortRecursive(data, mid, buffer, lessThan);
+  mergeSortRecursive(data + mid, (S) (n - mid), buffer, lessThan);
+
+  // If the 2 halves are already in order, there is nothing to merge.
+  if (! lessThan(data[mid], data[mid - 1])) return;
+
+  for (S i = 0; i < mid; i++) {
+    buffer[i] = data[i];
+  }
+
+  T* left = buffer;
+  T* leftEnd = buffer + mid;
+  T* right = data + mid;
+  T* rightEnd = data + n;
+  T* out = data;
+  while (left < leftEnd && right < rightEnd) {
+    if (lessThan(*right, *left)) {
+      *out++ = *right++;
+    } else {
+      *out++ = *left++;
+    }
+  }
+  while (left < leftEnd) {
+    *out++ = *left++;
+  }
+}
+
+}
+
+/**
+ * Merge sort. A stable O(n log(n)) sort which does not allocate any memory.
+ * Instead, the caller supplies a scratch `buffer` which must hold at least
+ * `n/2` elements. Sub-arrays smaller than ACE_SORTING_MERGE_SORT_THRESHOLD are
+ * sorted with insertionSort().
+ *
+ * Because the sort is stable, records can be sorted by multiple keys using
+ * multiple passes, first by the secondary key, then by the primary key.
+ *
+ * Average complexity: O(n log(n))
+ * Worst complexity: O(n log(n))
+ *
+ * The 3-argument version always delegates to the 4-argument version because
+ * the recursion happens in an internal function, so there is no
+ * ACE_SORTING_DIRECT_MERGE_SORT macro.
+ *
+ * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename S = uint16_t>
+void mergeSort(T data[], S n, T buffer[]) {
+  auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
+  mergeSort(data, n, buffer, lessThan);
+}
+
+/**
+ * Same as the 3-argument mergeSort() with the addition of a `lessThan` lambda
+ * expression or function.
+ *
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename F, typename S = uint16_t>
+void mergeSort(T data[], S n, T buffer[], F&& lessThan) {
+  internal::mergeSortRecursive(data, n, buffer, lessThan);
+}
+
+}
+
+#endif
@@ -0,0 +1,220 @@
+/*
+MIT License
+
+Copyright (c) 2021 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file mergeSortInPlace.h
+ *
+ * Stable merge sort which does not use a scratch buffer. The sorted runs are
+ * merged in place using rotations.
+ * See https://en.wikipedia.org/wiki/Merge_sort
+ */
+
+#ifndef ACE_SORTING_MERGE_SORT_IN_PLACE_H
+#define ACE_SORTING_MERGE_SORT_IN_PLACE_H
+
+#include "swap.h"
+#include "insertionSort.h"
+#include "mergeSort.h" // ACE_SORTING_MERGE_SORT_THRESHOLD
+
+namespace ace_sorting {
+
+namespace internal {
+
+/**
+ * Reverse the elements in [first, last).
+ *
+ * @tparam T type of data
+ */
+template <typename T>
+void reverseRange(T* first, T* last) {
+  while (first < last) {
+    last--;
+    swap(*first, *last);
+    first++;
+  }
+}
+
+/**
+ * Rotate [first, last) so that `middle` becomes the first element, using 3
+ * reversals. Returns the new position of the element originally at `first`.
+ *
+ * @tparam T type of data
+ */
+template <typename T>
+T* rotateRange(T* first, T* middle, T* last) {
+  reverseRange(first, middle);
+  reverseRange(middle, last);
+  reverseRange(first, last);
+  return first + (last - middle);
+}
+
+/**
+ * Merge the 2 adjacent sorted runs [data, data + n1) and [data + n1, data + n1
+ * + n2) in place, without a scratch buffer. The longer run is split in half,
+ * the split point of the other run is found with a binary search, and the 2
+ * inner pieces are swapped with a rotation. This leaves 2 smaller independent
+ * merges. The smaller one is handled through recursion and the larger one by
+ * the loop, so the recursion depth is O(log(n)).
+ *
+ * Small merges are faster using insertionSort(), which is O(n) for the 2
+ * sorted runs except for the inversions between them.
+ *
+ * Elements of the left run are placed before equal elements of the right run,
+ * which makes the merge stable.
+ *
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[]
+ */
+template <typename T, typename F, typename S>
+void mergeInPlace(T data[], S n1, S n2, F&& lessThan) {
+  while (n1 != 0 && n2 != 0) {
+    T* middle = data + n1;
+    if (n1 + n2 <= 2 * ACE_SORTING_MERGE_SORT_THRESHOLD) {
+      insertionSort(data, (S) (n1 + n2), lessThan);
+      return;
+    }
+
+    // Split the left run at n11 and the right run at n22.
+    S n11;
+    S n22;
+    if (n1 > n2) {
+      // First element of the right run which is >= data[n11].
+      n11 = n1 / 2;
+      S lo = 0;
+      S hi = n2;
+      while (lo < hi) {
+        S mid = lo + (hi - lo) / 2;
+        if (lessThan(middle[mid], data[n11])) {
+          lo = mid + 1;
+        } else {
+          hi = mid;
+        }
+      }
+      n22 = lo;
+    } else {
+      // First element of the left run which is > middle[n22].
+      n22 = n2 / 2;
+      S lo = 0;
+      S hi = n1;
+      while (lo < hi) {
+        S mid = lo + (hi - lo) / 2;
+        if (lessThan(middle[n22], data[mid])) {
+          hi = mid;
+        } else {
+          lo = mid + 1;
+        }
+      }
+      n11 = lo;
+    }
+
+    T* newMiddle = rotateRange(data + n11, middle, middle + n22);
+
+    // Merge [data, newMiddle) as (n11, n22), and [newMiddle, end) as
+    // (n1 - n11, n2 - n22).
+    S leftSize = n11 + n22;
+    S rightSize = (n1 - n11) + (n2 - n22);
+    if (leftSize < rightSize) {
+      mergeInPlace(data, n11, n22, lessThan);
+      data = newMiddle;
+      n1 = n1 - n11;
+      n2 = n2 - n22;
+    } else {
+      mergeInPlace(newMiddle, (S) (n1 - n11), (S) (n2 - n22), lessThan);
+      n1 = n11;
+      n2 = n22;
+    }
+  }
+}
+
+}
+
+/**
+ * Merge sort which does not need a scratch buffer. This is a stable sort like
+ * mergeSort(), but the adjacent sorted runs are merged in place using binary
+ * searches and rotations, instead of copying through a buffer. This trades
+ * some speed for memory: the comparisons remain O(n log(n)), but the number of
+ * element moves grows to O(n log(n)^2) in the worst case.
+ *
+ * The runs are built bottom-up: blocks of ACE_SORTING_MERGE_SORT_THRESHOLD
+ * elements are sorted with insertionSort(), then merged in passes of doubling
+ * widths. Only the merge step uses recursion, bounded by O(log(n)).
+ *
+ * Average complexity: O(n log(n)^2)
+ * Best complexity: O(n) if already sorted
+ *
+ * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename S = uint16_t>
+void mergeSortInPlace(T data[], S n) {
+  auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
+  mergeSortInPlace(data, n, lessThan);
+}
+
+/**
+ * Same as the 2-argument mergeSortInPlace() with the addition of a `lessThan`
+ * lambda expression or function.
+ *
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename F, typename S = uint16_t>
+void mergeSortInPlace(T data[], S n, F&& lessThan) {
+  const S blockSize = ACE_SORTING_MERGE_SORT_THRESHOLD;
+
+  // Sort each block using insertionSort().
+  T* block = data;
+  S remaining = n;
+  while (remaining > blockSize) {
+    insertionSort(block, blockSize, lessThan);
+    block += blockSize;
+    remaining -= blockSize;
+  }
+  insertionSort(block, remaining, lessThan);
+
+  // Merge adjacent runs of 'width', doubling the width each pass. The width is
+  // set to 'n' instead of being doubled when doubling would exceed 'n', to
+  // prevent overflow of S.
+  for (S width = blockSize; width < n;
+      width = (width > n / 2) ? n : (S) (width * 2)) {
+    T* left = data;
+    remaining = n;
+    while (remaining > width) {
+      S n2 = remaining - width;
+      if (n2 > width) n2 = width;
+
+      // Skip the merge if the 2 runs are already in order.
+      if (lessThan(left[width], left[width - 1])) {
+        internal::mergeInPlace(left, width, n2, lessThan);
+      }
+      left += width + n2;
+      remaining -= width + n2;
+    }
+  }
+}
+
+}
+
+#endif
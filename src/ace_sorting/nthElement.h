@@ -0,0 +1,230 @@
+/*
+MIT License
+
+Copyright (c) 2021 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file nthElement.h
+ *
+ * Selection of the k-th smallest element (quickselect), with a median of
+ * medians fallback. See https://en.wikipedia.org/wiki/Quickselect and
+ * https://en.wikipedia.org/wiki/Median_of_medians
+ */
+
+#ifndef ACE_SORTING_NTH_ELEMENT_H
+#define ACE_SORTING_NTH_ELEMENT_H
+
+#include <stdint.h> // uint8_t, uint16_t
+#include "swap.h"
+#include "insertionSort.h"
+#include "introSort.h" // introSortDepthLimit()
+#include "typeIdentity.h"
+
+namespace ace_sorting {
+
+namespace internal {
+
+/**
+ * Partitions smaller than or equal to this size are sorted using
+ * insertionSort() instead of being partitioned further.
+ */
+const uint8_t kNthElementThreshold = 8;
+
+/**
+ * Return the median of medians of data[] as the pivot, which is guaranteed to
+ * be larger than at least 3/10 and smaller than at least 3/10 of the
+ * elements. Each group of 5 elements is sorted with insertionSort() and its
+ * median is moved to the front of the array, then the median of those
+ * `n / 5` medians is selected recursively.
+ *
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[]
+ */
+template <typename T, typename F, typename S>
+T medianOfMedians(T data[], S n, F&& lessThan);
+
+/**
+ * Iterative part of nthElement(). Partitions using the same median-of-3 pivot
+ * and the same loop as quickSortMedianSwapped(), but continues only with the
+ * partition which contains the index `k`. When `depthLimit` drops to 0, the
+ * pivot is selected using medianOfMedians() instead, which guarantees that
+ * each partition removes at least 3/10 of the elements. The median of
+ * medians is itself selected using a `depthLimit` of 0, so the runtime is
+ * linear in the worst case.
+ *
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[]
+ */
+template <typename T, typename F, typename S>
+void nthElementIterative(T data[], S n, S k, uint8_t depthLimit, F&& lessThan) {
+  while (n > kNthElementThreshold) {
+    T pivot;
+    T* left;
+    T* right;
+    if (depthLimit == 0) {
+      pivot = medianOfMedians(data, n, lessThan);
+      left = data;
+      right = data + n - 1;
+    } else {
+      depthLimit--;
+
+      // Select the median of data[low], data[mid], and data[high] as the
+      // estimate of the ideal pivot. In the process, the (low, mid, high)
+      // become sorted.
+      S mid = n / 2;
+      pivot = data[mid];
+      if (lessThan(data[n - 1], data[0])) {
+        swap(data[0], data[n - 1]);
+      }
+      if (lessThan(pivot, data[0])) {
+        swap(data[0], data[mid]);
+      } else if (lessThan(data[n - 1], pivot)) {
+        swap(data[mid], data[n - 1]);
+      }
+      pivot = data[mid];
+
+      // We can skip the low and high because they are already sorted.
+      left = data + 1;
+      right = data + n - 2;
+    }
+
+    while (left <= right) {
+      if (lessThan(*left, pivot)) {
+        left++;
+      } else if (lessThan(pivot, *right)) {
+        right--;
+      } else {
+        swap(*left, *right);
+        left++;
+        right--;
+      }
+    }
+
+    // The elements between 'right' and 'left' (if any) are equal to the pivot,
+    // so they are already in their final position.
+    S nLeft = right - data + 1;
+    S nStart = left - data;
+    if (k < nLeft) {
+      n = nLeft;
+    } else if (k >= nStart) {
+      data = left;
+      n -= nStart;
+      k -= nStart;
+    } else {
+      return;
+    }
+  }
+
+  insertionSort(data, n, lessThan);
+}
+
+template <typename T, typename F, typename S>
+T medianOfMedians(T data[], S n, F&& lessThan) {
+  S numGroups = 0;
+  for (S i = 0; n - i >= 5; i += 5) {
+    insertionSort(data + i, (S) 5, lessThan);
+    swap(data[numGroups], data[i + 2]);
+    numGroups++;
+  }
+  S mid = numGroups / 2;
+  nthElementIterative(data, numGroups, mid, (uint8_t) 0, lessThan);
+  return data[mid];
+}
+
+}
+
+/**
+ * Rearrange data[] so that data[k] is the element which would be at index `k`
+ * if the whole array were sorted. All elements before data[k] are less than
+ * or equal to it, and all elements after data[k] are greater than or equal to
+ * it, in unspecified order. Equivalent to std::nth_element(). Does nothing if
+ * `k >= n`.
+ *
+ * Uses quickselect with the same median-of-3 partitioning as
+ * quickSortMedianSwapped(), which continues only with the partition that
+ * contains `k`. If the number of partitioning steps exceeds 2*log2(n) (same as
+ * introSort()), the pivot is selected using the median of medians, which
+ * guarantees a linear runtime. Does not use recursion, except for the median
+ * of medians of `n / 5` elements.
+ *
+ * Average complexity: O(n)
+ * Worst complexity: O(n)
+ *
+ * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename S = uint16_t>
+void nthElement(T data[], S n, typename internal::TypeIdentity<S>::type k) {
+  auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
+  nthElement(data, n, k, lessThan);
+}
+
+/**
+ * Same as the 3-argument nthElement() with the addition of a `lessThan`
+ * lambda expression or function.
+ *
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename F, typename S = uint16_t>
+void nthElement(
+    T data[], S n, typename internal::TypeIdentity<S>::type k, F&& lessThan) {
+  if (k >= n) return;
+  internal::nthElementIterative(
+      data, n, k, internal::introSortDepthLimit(n), lessThan);
+}
+
+/**
+ * Return the median of data[] using nthElement(), which rearranges the
+ * array. If `n` is even, the upper of the 2 middle elements, data[n/2], is
+ * returned, so that the result is always one of the elements (no averaging of
+ * integer types). The array must not be empty.
+ *
+ * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename S = uint16_t>
+T median(T data[], S n) {
+  auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
+  return median(data, n, lessThan);
+}
+
+/**
+ * Same as the 2-argument median() with the addition of a `lessThan` lambda
+ * expression or function.
+ *
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename F, typename S = uint16_t>
+T median(T data[], S n, F&& lessThan) {
+  S mid = n / 2;
+  nthElement(data, n, mid, lessThan);
+  return data[mid];
+}
+
+}
+
+#endif
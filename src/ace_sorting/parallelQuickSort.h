@@ -0,0 +1,284 @@
+/*
+MIT License
+
+Copyright (c) 2021 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file parallelQuickSort.h
+ *
+ * Multithreaded quick sort for Linux and MacOS hosts (e.g. under EpoxyDuino),
+ * using a small work-stealing pool of std::thread. On microcontrollers, it
+ * falls back to the serial pdqSort().
+ */
+
+#ifndef ACE_SORTING_PARALLEL_QUICK_SORT_H
+#define ACE_SORTING_PARALLEL_QUICK_SORT_H
+
+#include <stdint.h> // uint8_t, uint16_t
+#include "quickSortBlock.h" // moveMedianToFirst(), BlockPartition
+#include "pdqSort.h"
+
+#if ! defined(ACE_SORTING_THREADS)
+  #if defined(EPOXY_DUINO) || defined(__linux__) || defined(__APPLE__)
+    /**
+     * Set to 1 if std::thread is available, which enables the thread pool of
+     * parallelQuickSort(). Can be defined to 0 before including
+     * <AceSorting.h> to disable it.
+     */
+    #define ACE_SORTING_THREADS 1
+  #else
+    #define ACE_SORTING_THREADS 0
+  #endif
+#endif
+
+#if ! defined(ACE_SORTING_PARALLEL_QUICK_SORT_THRESHOLD)
+  /**
+   * Partitions smaller than or equal to this size are sorted by a single
+   * thread using pdqSort(), instead of being partitioned further into tasks
+   * which can be stolen by the other threads.
+   */
+  #define ACE_SORTING_PARALLEL_QUICK_SORT_THRESHOLD 16384
+#endif
+
+#if ACE_SORTING_THREADS
+  #include <atomic>
+  #include <deque>
+  #include <mutex>
+  #include <thread>
+  #include <vector>
+#endif
+
+namespace ace_sorting {
+
+namespace internal {
+
+#if ACE_SORTING_THREADS
+
+/**
+ * A pool of threads which sort the partitions of a single array. Each thread
+ * owns a double-ended queue of partitions (tasks). A thread partitions its
+ * task, pushes one side onto the back of its own queue, and continues with the
+ * other side until it becomes smaller than the threshold, which is then sorted
+ * serially. An idle thread takes the most recent task at the back of its own
+ * queue, or steals the oldest (and usually largest) task at the front of the
+ * queue of another thread.
+ *
+ * The sort is finished when every element is in its final position, which is
+ * tracked by counting down the number of remaining elements: 1 for each pivot,
+ * and `n` for each partition sorted serially.
+ *
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[]
+ */
+template <typename T, typename F, typename S>
+class ParallelQuickSort {
+  public:
+    ParallelQuickSort(F& lessThan, uint8_t numThreads) :
+        mLessThan(lessThan),
+        mNumThreads(numThreads),
+        mQueues(numThreads)
+    {}
+
+    void sort(T data[], S n) {
+      // Limit the parallel partitioning depth like introSort(), so that a bad
+      // sequence of pivots hands the partition to pdqSort(), which guarantees
+      // O(n log(n)).
+      uint8_t depthLimit = 0;
+      for (S m = n; m > 1; m >>= 1) {
+        depthLimit += 2;
+      }
+
+      mRemaining = n;
+      mQueues[0].tasks.push_back(Task{data, n, depthLimit});
+
+      // The calling thread is worker 0.
+      std::vector<std::thread> threads;
+      for (uint8_t i = 1; i < mNumThreads; i++) {
+        threads.emplace_back(&ParallelQuickSort::work, this, i);
+      }
+      work(0);
+      for (std::thread& thread : threads) {
+        thread.join();
+      }
+    }
+
+  private:
+    struct Task {
+      T* data;
+      S n;
+      uint8_t depthLimit;
+    };
+
+    struct Queue {
+      std::mutex mutex;
+      std::deque<Task> tasks;
+    };
+
+    void work(uint8_t id) {
+      Task task;
+      while (mRemaining.load() > 0) {
+        if (popTask(id, task) || stealTask(id, task)) {
+          runTask(id, task);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    }
+
+    bool popTask(uint8_t id, Task& task) {
+      Queue& queue = mQueues[id];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (queue.tasks.empty()) return false;
+      task = queue.tasks.back();
+      queue.tasks.pop_back();
+      return true;
+    }
+
+    bool stealTask(uint8_t id, Task& task) {
+      for (uint8_t i = 1; i < mNumThreads; i++) {
+        Queue& queue = mQueues[(id + i) % mNumThreads];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) continue;
+        task = queue.tasks.front();
+        queue.tasks.pop_front();
+        return true;
+      }
+      return false;
+    }
+
+    void runTask(uint8_t id, Task task) {
+      T* data = task.data;
+      S n = task.n;
+      uint8_t depthLimit = task.depthLimit;
+
+      while (n > ACE_SORTING_PARALLEL_QUICK_SORT_THRESHOLD && depthLimit > 0) {
+        depthLimit--;
+        moveMedianToFirst(data, n, mLessThan);
+        bool alreadyPartitioned;
+        S pivotPos = BlockPartition<T>::partition(
+            data, n, mLessThan, alreadyPartitioned);
+
+        // The pivot is the smallest element, so skip over all the elements
+        // equal to it, like quickSortBlock(), instead of queuing a partition
+        // of n-1 elements.
+        if (pivotPos == 0) {
+          S numEqual = partitionEqual(data, n, mLessThan);
+          mRemaining -= numEqual;
+          data += numEqual;
+          n -= numEqual;
+          continue;
+        }
+        mRemaining -= 1;
+
+        // Offer the larger partition to the other threads, and continue with
+        // the smaller one.
+        S nLeft = pivotPos;
+        S nRight = n - pivotPos - 1;
+        T* right = data + pivotPos + 1;
+        Queue& queue = mQueues[id];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (nLeft < nRight) {
+          queue.tasks.push_back(Task{right, nRight, depthLimit});
+          n = nLeft;
+        } else {
+          queue.tasks.push_back(Task{data, nLeft, depthLimit});
+          data = right;
+          n = nRight;
+        }
+      }
+
+      pdqSort(data, n, mLessThan);
+      mRemaining -= n;
+    }
+
+    F& mLessThan;
+    uint8_t const mNumThreads;
+    std::vector<Queue> mQueues;
+    std::atomic<S> mRemaining;
+};
+
+#endif
+
+}
+
+/**
+ * Multithreaded quick sort. The array is partitioned using the same median of
+ * 3 pivot and block partition as quickSortBlock(), and the partitions larger
+ * than ACE_SORTING_PARALLEL_QUICK_SORT_THRESHOLD are distributed over a pool
+ * of `numThreads` threads (including the calling thread) which steal work
+ * from each other. Smaller partitions are sorted by a single thread using
+ * pdqSort().
+ *
+ * The threads are created and joined on every call, which costs tens of
+ * microseconds, so this is only useful for large arrays, of a million
+ * elements or more.
+ *
+ * If `numThreads` is 0, the number of hardware threads reported by
+ * std::thread::hardware_concurrency() is used. If ACE_SORTING_THREADS is 0
+ * (e.g. on microcontrollers), the array is sorted using pdqSort() by the
+ * calling thread.
+ *
+ * Average complexity: O(n log(n) / numThreads)
+ * Worst complexity: O(n log(n))
+ *
+ * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename S = uint16_t>
+void parallelQuickSort(T data[], S n, uint8_t numThreads) {
+  auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
+  parallelQuickSort(data, n, lessThan, numThreads);
+}
+
+/**
+ * Same as the 3-argument parallelQuickSort() with the addition of a
+ * `lessThan` lambda expression or function, which is called concurrently by
+ * multiple threads, so it must not modify any shared state.
+ *
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename F, typename S = uint16_t>
+void parallelQuickSort(T data[], S n, F&& lessThan, uint8_t numThreads) {
+#if ACE_SORTING_THREADS
+  if (numThreads == 0) {
+    unsigned hardwareThreads = std::thread::hardware_concurrency();
+    numThreads = (hardwareThreads == 0) ? 1
+        : (hardwareThreads > 255) ? 255
+        : hardwareThreads;
+  }
+  if (numThreads > 1 && n > ACE_SORTING_PARALLEL_QUICK_SORT_THRESHOLD) {
+    internal::ParallelQuickSort<T, F, S> sorter(lessThan, numThreads);
+    sorter.sort(data, n);
+    return;
+  }
+#else
+  (void) numThreads;
+#endif
+
+  pdqSort(data, n, lessThan);
+}
+
+}
+
+#endif
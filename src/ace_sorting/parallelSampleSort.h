@@ -0,0 +1,328 @@
+/*
+MIT License
+
+Copyright (c) 2021 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file parallelSampleSort.h
+ *
+ * Multithreaded sample sort for Linux and MacOS hosts (e.g. under EpoxyDuino),
+ * which distributes the array into buckets using sampled splitters, and sorts
+ * the buckets in parallel. On microcontrollers, it falls back to the serial
+ * pdqSort().
+ */
+
+#ifndef ACE_SORTING_PARALLEL_SAMPLE_SORT_H
+#define ACE_SORTING_PARALLEL_SAMPLE_SORT_H
+
+#include <stdint.h> // uint8_t, uint16_t, uint32_t
+#include "pdqSort.h"
+#include "parallelQuickSort.h" // ACE_SORTING_THREADS
+
+#if ! defined(ACE_SORTING_PARALLEL_SAMPLE_SORT_THRESHOLD)
+  /**
+   * Arrays smaller than or equal to this size are sorted by the calling
+   * thread using pdqSort(), because distributing them into buckets costs more
+   * than it saves.
+   */
+  #define ACE_SORTING_PARALLEL_SAMPLE_SORT_THRESHOLD 65536
+#endif
+
+#if ACE_SORTING_THREADS
+  #include <atomic>
+  #include <thread>
+  #include <vector>
+#endif
+
+namespace ace_sorting {
+
+namespace internal {
+
+#if ACE_SORTING_THREADS
+
+/**
+ * Number of buckets per thread. More buckets than threads allows a thread
+ * which finishes early to pick up another bucket, which balances the load
+ * when the buckets end up with different sizes.
+ */
+static const uint8_t kParallelSampleSortBucketsPerThread = 4;
+
+/**
+ * Number of samples per bucket. The splitters are every k-th element of the
+ * sorted samples, so a larger oversampling factor gives buckets of more
+ * uniform size.
+ */
+static const uint8_t kParallelSampleSortOversampling = 16;
+
+/**
+ * Sample sort of a single array using a pool of threads. The array is sorted
+ * in 3 phases, each running on all threads:
+ *
+ * 1) Each thread classifies the elements of its own contiguous chunk of
+ *    data[], and counts the number of elements in each bucket.
+ * 2) Each thread copies the elements of its chunk into their bucket in the
+ *    scratch buffer[], at the offsets computed from the counts of phase 1.
+ * 3) The threads take the buckets one at a time, sort them using pdqSort(),
+ *    and copy them back into data[].
+ *
+ * The buckets are defined by the `m` unique splitters selected from a random
+ * sample of the array. Besides the `m+1` buckets between the splitters, there
+ * is an equality bucket for each splitter, which holds the elements equal to
+ * that splitter, and does not need to be sorted. Arrays with many copies of
+ * a few values are therefore not concentrated into a single large bucket.
+ *
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[]
+ */
+template <typename T, typename F, typename S>
+class ParallelSampleSort {
+  public:
+    ParallelSampleSort(
+        T data[], S n, T buffer[], F& lessThan, uint8_t numThreads) :
+        mData(data),
+        mBuffer(buffer),
+        mLessThan(lessThan),
+        mN(n),
+        mNumThreads(numThreads)
+    {}
+
+    void sort() {
+      selectSplitters();
+      mNumBuckets = 2 * mSplitters.size() + 1;
+      mCounts.assign((size_t) mNumThreads * mNumBuckets, 0);
+      mBucketStarts.resize(mNumBuckets + 1);
+
+      runThreads(&ParallelSampleSort::countBuckets);
+      computeOffsets();
+      runThreads(&ParallelSampleSort::distribute);
+      mNextBucket = 0;
+      runThreads(&ParallelSampleSort::sortBuckets);
+    }
+
+  private:
+    typedef void (ParallelSampleSort::*Phase)(uint8_t id);
+
+    /** Run the given phase on all threads, including the calling thread. */
+    void runThreads(Phase phase) {
+      std::vector<std::thread> threads;
+      for (uint8_t i = 1; i < mNumThreads; i++) {
+        threads.emplace_back(phase, this, i);
+      }
+      (this->*phase)(0);
+      for (std::thread& thread : threads) {
+        thread.join();
+      }
+    }
+
+    /**
+     * Sort a pseudo-random sample of the array, and select every
+     * kParallelSampleSortOversampling-th element as a splitter, skipping
+     * duplicates.
+     */
+    void selectSplitters() {
+      uint16_t numBuckets =
+          (uint16_t) mNumThreads * kParallelSampleSortBucketsPerThread;
+      uint16_t numSamples = numBuckets * kParallelSampleSortOversampling;
+      if (numSamples > mN) numSamples = mN;
+
+      // A fixed xorshift32 sequence, so that the sort is deterministic.
+      std::vector<T> samples;
+      samples.reserve(numSamples);
+      uint32_t random = 2463534242U;
+      for (uint16_t i = 0; i < numSamples; i++) {
+        random ^= random << 13;
+        random ^= random >> 17;
+        random ^= random << 5;
+        samples.push_back(mData[random % mN]);
+      }
+      pdqSort(samples.data(), numSamples, mLessThan);
+
+      uint16_t step = numSamples / numBuckets;
+      if (step == 0) step = 1;
+      mSplitters.clear();
+      mSplitters.push_back(samples[step - 1]);
+      for (uint16_t i = 2 * step - 1; i < numSamples - 1; i += step) {
+        if (mLessThan(mSplitters.back(), samples[i])) {
+          mSplitters.push_back(samples[i]);
+        }
+      }
+    }
+
+    /**
+     * Return the bucket of the given element: `2j` if it is between the
+     * splitters `j-1` and `j`, or `2j-1` if it is equal to splitter `j-1`.
+     * The binary search is branchless, because the comparisons of random
+     * data are unpredictable.
+     */
+    uint16_t classify(const T& x) const {
+      const T* splitters = mSplitters.data();
+      const T* base = splitters;
+      uint16_t len = mSplitters.size();
+      while (len > 1) {
+        uint16_t half = len / 2;
+        base = mLessThan(x, base[half]) ? base : base + half;
+        len -= half;
+      }
+      uint16_t j = (base - splitters) + ! mLessThan(x, *base);
+      bool isEqual = (j > 0) && ! mLessThan(splitters[j - 1], x);
+      return 2 * j - isEqual;
+    }
+
+    /** Return the start of the chunk of data[] owned by the given thread. */
+    S chunkStart(uint8_t id) const {
+      return (id == mNumThreads) ? mN : (mN / mNumThreads) * id;
+    }
+
+    void countBuckets(uint8_t id) {
+      S* counts = &mCounts[(size_t) id * mNumBuckets];
+      S end = chunkStart(id + 1);
+      for (S i = chunkStart(id); i < end; i++) {
+        counts[classify(mData[i])]++;
+      }
+    }
+
+    /**
+     * Convert the counts of each bucket and thread into the offset in
+     * buffer[] where the thread copies its first element of that bucket.
+     */
+    void computeOffsets() {
+      S offset = 0;
+      for (uint16_t b = 0; b < mNumBuckets; b++) {
+        mBucketStarts[b] = offset;
+        for (uint8_t id = 0; id < mNumThreads; id++) {
+          S& count = mCounts[(size_t) id * mNumBuckets + b];
+          S start = offset;
+          offset += count;
+          count = start;
+        }
+      }
+      mBucketStarts[mNumBuckets] = offset;
+    }
+
+    void distribute(uint8_t id) {
+      S* offsets = &mCounts[(size_t) id * mNumBuckets];
+      S end = chunkStart(id + 1);
+      for (S i = chunkStart(id); i < end; i++) {
+        mBuffer[offsets[classify(mData[i])]++] = mData[i];
+      }
+    }
+
+    void sortBuckets(uint8_t /*id*/) {
+      uint16_t b;
+      while ((b = mNextBucket++) < mNumBuckets) {
+        S start = mBucketStarts[b];
+        S n = mBucketStarts[b + 1] - start;
+        T* bucket = mBuffer + start;
+
+        // The odd buckets hold the elements equal to a splitter.
+        if ((b & 0x1) == 0) {
+          pdqSort(bucket, n, mLessThan);
+        }
+        T* data = mData + start;
+        for (S i = 0; i < n; i++) {
+          data[i] = bucket[i];
+        }
+      }
+    }
+
+    T* const mData;
+    T* const mBuffer;
+    F& mLessThan;
+    S const mN;
+    uint8_t const mNumThreads;
+    uint16_t mNumBuckets;
+    std::vector<T> mSplitters;
+    std::vector<S> mCounts;
+    std::vector<S> mBucketStarts;
+    std::atomic<uint16_t> mNextBucket;
+};
+
+#endif
+
+}
+
+/**
+ * Multithreaded sample sort. A random sample of the array selects splitters
+ * which divide the array into about `4 * numThreads` buckets. The threads
+ * (including the calling thread) distribute their own part of the array into
+ * the buckets in the scratch `buffer`, which must hold `n` elements. Then
+ * each bucket is sorted by one of the threads using pdqSort(), and copied
+ * back into `data`.
+ *
+ * Unlike parallelQuickSort(), every pass over the array is divided among all
+ * threads from the start, so it scales better with the number of threads, at
+ * the cost of a buffer as large as the array.
+ *
+ * If `numThreads` is 0, the number of hardware threads reported by
+ * std::thread::hardware_concurrency() is used. If ACE_SORTING_THREADS is 0
+ * (e.g. on microcontrollers), the array is sorted using pdqSort() by the
+ * calling thread, and `buffer` is not used.
+ *
+ * Average complexity: O(n log(n) / numThreads)
+ * Worst complexity: O(n log(n))
+ *
+ * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename S = uint16_t>
+void parallelSampleSort(T data[], S n, T buffer[], uint8_t numThreads) {
+  auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
+  parallelSampleSort(data, n, buffer, lessThan, numThreads);
+}
+
+/**
+ * Same as the 4-argument parallelSampleSort() with the addition of a
+ * `lessThan` lambda expression or function, which is called concurrently by
+ * multiple threads, so it must not modify any shared state.
+ *
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename F, typename S = uint16_t>
+void parallelSampleSort(
+    T data[], S n, T buffer[], F&& lessThan, uint8_t numThreads) {
+#if ACE_SORTING_THREADS
+  if (numThreads == 0) {
+    unsigned hardwareThreads = std::thread::hardware_concurrency();
+    numThreads = (hardwareThreads == 0) ? 1
+        : (hardwareThreads > 255) ? 255
+        : hardwareThreads;
+  }
+  if (numThreads > 1 && n > ACE_SORTING_PARALLEL_SAMPLE_SORT_THRESHOLD) {
+    internal::ParallelSampleSort<T, F, S> sorter(
+        data, n, buffer, lessThan, numThreads);
+    sorter.sort();
+    return;
+  }
+#else
+  (void) buffer;
+  (void) numThreads;
+#endif
+
+  pdqSort(data, n, lessThan);
+}
+
+}
+
+#endif
@@ -0,0 +1,193 @@
+/*
+MIT License
+
+Copyright (c) 2021 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file partialSort.h
+ *
+ * Partial sort and top-K selection using a bounded max-heap of K elements.
+ * See https://en.wikipedia.org/wiki/Partial_sorting
+ */
+
+#ifndef ACE_SORTING_PARTIAL_SORT_H
+#define ACE_SORTING_PARTIAL_SORT_H
+
+#include <stdint.h> // uint16_t
+#include "swap.h"
+#include "typeIdentity.h"
+
+namespace ace_sorting {
+
+namespace internal {
+
+/**
+ * Sift down heap[root] in the max-heap of `n` elements, like the inner loop of
+ * heapSort(). The loop condition guarantees that (2 * root + 1) cannot
+ * overflow S.
+ */
+template <typename T, typename F, typename S>
+void siftDown(T heap[], S root, S n, F&& lessThan) {
+  T temp = heap[root];
+  while (root < n / 2) {
+    S child = 2 * root + 1;
+    if (child + 1 < n && lessThan(heap[child], heap[child + 1])) child++;
+    if (! lessThan(temp, heap[child])) break;
+    heap[root] = heap[child];
+    root = child;
+  }
+  heap[root] = temp;
+}
+
+/** Rearrange the `n` elements of heap[] into a max-heap. */
+template <typename T, typename F, typename S>
+void makeHeap(T heap[], S n, F&& lessThan) {
+  for (S start = n / 2; start > 0; ) {
+    start--;
+    siftDown(heap, start, n, lessThan);
+  }
+}
+
+/** Sort the max-heap of `n` elements in ascending order. */
+template <typename T, typename F, typename S>
+void sortHeap(T heap[], S n, F&& lessThan) {
+  for (S end = n; end > 1; ) {
+    end--;
+    swap(heap[0], heap[end]);
+    siftDown(heap, (S) 0, end, lessThan);
+  }
+}
+
+}
+
+/**
+ * Partial sort. Rearrange data[] so that the `k` smallest elements are at the
+ * front of the array, in ascending order. The order of the remaining `n - k`
+ * elements is unspecified.
+ *
+ * The first `k` elements are arranged into a max-heap. Each remaining element
+ * which is smaller than the largest element of the heap replaces it, and is
+ * sifted down. Finally, the heap is sorted. When `k` is much smaller than `n`
+ * (e.g. the 10 smallest of 1000 elements), most elements are rejected by a
+ * single comparison with the top of the heap. Does not use recursion or any
+ * additional memory.
+ *
+ * If `k >= n`, the whole array is sorted using the heap sort.
+ *
+ * Average complexity: O(n log(k))
+ * Worst complexity: O(n log(k))
+ *
+ * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename S = uint16_t>
+void partialSort(T data[], S n, typename internal::TypeIdentity<S>::type k) {
+  auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
+  partialSort(data, n, k, lessThan);
+}
+
+/**
+ * Same as the 3-argument partialSort() with the addition of a `lessThan`
+ * lambda expression or function. For example, a `lessThan` which returns
+ * `a > b` moves the `k` largest elements to the front, in descending order.
+ *
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename F, typename S = uint16_t>
+void partialSort(
+    T data[], S n, typename internal::TypeIdentity<S>::type k, F&& lessThan) {
+  if (k > n) k = n;
+  if (k == 0) return;
+
+  internal::makeHeap(data, k, lessThan);
+  for (S i = k; i < n; i++) {
+    if (lessThan(data[i], data[0])) {
+      swap(data[0], data[i]);
+      internal::siftDown(data, (S) 0, k, lessThan);
+    }
+  }
+  internal::sortHeap(data, k, lessThan);
+}
+
+/**
+ * Top-K selection. Copy the `k` largest elements of data[] into result[], in
+ * descending order, without modifying data[]. The result[] array must hold
+ * at least `k` elements. If `k > n`, only the first `n` elements of result[]
+ * are filled.
+ *
+ * Uses the same bounded heap as partialSort(), but the heap is built in
+ * result[], with the smallest of the current top `k` elements at its root, so
+ * that each element of data[] is read only once. Useful to find the peaks of
+ * a buffer of sensor readings which must be kept in its original order.
+ *
+ * Average complexity: O(n log(k))
+ * Worst complexity: O(n log(k))
+ *
+ * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename S = uint16_t>
+void topK(
+    const T data[], S n, T result[],
+    typename internal::TypeIdentity<S>::type k) {
+  auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
+  topK(data, n, result, k, lessThan);
+}
+
+/**
+ * Same as the 4-argument topK() with the addition of a `lessThan` lambda
+ * expression or function. The result contains the `k` largest elements
+ * according to `lessThan`, largest first.
+ *
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename F, typename S = uint16_t>
+void topK(
+    const T data[], S n, T result[],
+    typename internal::TypeIdentity<S>::type k, F&& lessThan) {
+  if (k > n) k = n;
+  if (k == 0) return;
+
+  // A max-heap of the reversed order keeps the smallest element at the root.
+  auto&& greaterThan = [&lessThan](const T& a, const T& b) -> bool {
+    return lessThan(b, a);
+  };
+
+  for (S i = 0; i < k; i++) {
+    result[i] = data[i];
+  }
+  internal::makeHeap(result, k, greaterThan);
+  for (S i = k; i < n; i++) {
+    if (lessThan(result[0], data[i])) {
+      result[0] = data[i];
+      internal::siftDown(result, (S) 0, k, greaterThan);
+    }
+  }
+  internal::sortHeap(result, k, greaterThan);
+}
+
+}
+
+#endif
@@ -0,0 +1,282 @@
+/*
+MIT License
+
+Copyright (c) 2021 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file pdqSort.h
+ *
+ * Pattern-defeating quicksort.
+ * See https://github.com/orlp/pdqsort and "Pattern-defeating Quicksort" by
+ * Orson Peters, https://arxiv.org/abs/2106.05123
+ */
+
+#ifndef ACE_SORTING_PDQ_SORT_H
+#define ACE_SORTING_PDQ_SORT_H
+
+#include <stdint.h> // uint8_t, uint16_t
+#include "swap.h"
+#include "insertionSort.h"
+#include "heapSort.h"
+#include "mergeSortInPlace.h" // reverseRange()
+#include "quickSortBlock.h" // sort3(), partitionRight(), BlockPartition
+
+#if ! defined(ACE_SORTING_PDQ_SORT_THRESHOLD)
+  /**
+   * Partitions smaller than this size are sorted using insertionSort()
+   * instead of being partitioned further.
+   */
+  #define ACE_SORTING_PDQ_SORT_THRESHOLD 24
+#endif
+
+namespace ace_sorting {
+
+namespace internal {
+
+/**
+ * Partitions larger than this use the median of 3 medians of 3 (Tukey's
+ * ninther) as the pivot, instead of the median of 3.
+ */
+const uint8_t kPdqSortNintherThreshold = 128;
+
+/**
+ * Maximum number of elements that partialInsertionSort() is allowed to move
+ * before giving up.
+ */
+const uint8_t kPdqSortPartialInsertionLimit = 8;
+
+/**
+ * Insertion sort which gives up if more than kPdqSortPartialInsertionLimit
+ * elements must be moved. Returns true if data[] is sorted.
+ */
+template <typename T, typename F, typename S>
+bool partialInsertionSort(T data[], S n, F&& lessThan) {
+  S limit = 0;
+  for (S i = 1; i < n; i++) {
+    if (! lessThan(data[i], data[i - 1])) continue;
+
+    T temp = data[i];
+    S j = i;
+    do {
+      data[j] = data[j - 1];
+      j--;
+    } while (j > 0 && lessThan(temp, data[j - 1]));
+    data[j] = temp;
+
+    limit += i - j;
+    if (limit > kPdqSortPartialInsertionLimit) return false;
+  }
+  return true;
+}
+
+/**
+ * Partition data[] around the pivot in data[0], placing the elements equal to
+ * the pivot on the left. Returns the final position `p` of the pivot, such
+ * that data[0..p] <= pivot < data(p..n). Used when the pivot is equal to the
+ * element before data[], which is known to be smaller than or equal to all
+ * the elements in data[], so that the elements equal to the pivot never need
+ * to be partitioned again.
+ */
+template <typename T, typename F, typename S>
+S partitionLeft(T data[], S n, F&& lessThan) {
+  T pivot = data[0];
+  S first = 0;
+  S last = n;
+
+  while (lessThan(pivot, data[--last])) {}
+  if (last + 1 == n) {
+    while (first < last && ! lessThan(pivot, data[++first])) {}
+  } else {
+    while (! lessThan(pivot, data[++first])) {}
+  }
+
+  while (first < last) {
+    swap(data[first], data[last]);
+    while (lessThan(pivot, data[--last])) {}
+    while (! lessThan(pivot, data[++first])) {}
+  }
+
+  data[0] = data[last];
+  data[last] = pivot;
+  return last;
+}
+
+/**
+ * Swap a few elements at 1/4 of a partition with the elements at its ends,
+ * to break the pattern which produced a highly unbalanced partition.
+ */
+template <typename T, typename S>
+void pdqSortShuffle(T data[], S n) {
+  S quarter = n / 4;
+  swap(data[0], data[quarter]);
+  swap(data[n - 1], data[n - quarter]);
+  if (n > kPdqSortNintherThreshold) {
+    swap(data[1], data[quarter + 1]);
+    swap(data[2], data[quarter + 2]);
+    swap(data[n - 2], data[n - (quarter + 1)]);
+    swap(data[n - 3], data[n - (quarter + 2)]);
+  }
+}
+
+/**
+ * Recursive part of pdqSort(). The smaller partition is handled through
+ * recursion and the larger partition is handled by the loop, like
+ * introSortRecursive(), so the recursion depth never exceeds log2(n).
+ *
+ * @param leftmost true if data[] is the leftmost partition, i.e. there is no
+ *    element before data[0]
+ * @param badAllowed number of highly unbalanced partitions allowed before
+ *    switching to heapSort()
+ */
+template <typename T, typename F, typename S>
+void pdqSortRecursive(
+    T data[], S n, F&& lessThan, uint8_t badAllowed, bool leftmost) {
+  while (n >= ACE_SORTING_PDQ_SORT_THRESHOLD) {
+    // Move the pivot into data[0].
+    S mid = n / 2;
+    if (n > kPdqSortNintherThreshold) {
+      sort3(data[0], data[mid], data[n - 1], lessThan);
+      sort3(data[1], data[mid - 1], data[n - 2], lessThan);
+      sort3(data[2], data[mid + 1], data[n - 3], lessThan);
+      sort3(data[mid - 1], data[mid], data[mid + 1], lessThan);
+      swap(data[0], data[mid]);
+    } else {
+      sort3(data[mid], data[0], data[n - 1], lessThan);
+    }
+
+    // If the pivot is equal to the element before this partition, then every
+    // element equal to the pivot is already in its final position. Group them
+    // on the left and continue with the elements greater than the pivot.
+    // This makes data with many duplicate keys O(N log(K)).
+    if (! leftmost && ! lessThan(*(data - 1), data[0])) {
+      S pivotPos = partitionLeft(data, n, lessThan) + 1;
+      data += pivotPos;
+      n -= pivotPos;
+      continue;
+    }
+
+    bool alreadyPartitioned;
+    S pivotPos = BlockPartition<T>::partition(
+        data, n, lessThan, alreadyPartitioned);
+    S nLeft = pivotPos;
+    S nRight = n - pivotPos - 1;
+    T* right = data + pivotPos + 1;
+
+    bool highlyUnbalanced = nLeft < n / 8 || nRight < n / 8;
+    if (highlyUnbalanced) {
+      // Too many bad partitions. Fall back to O(n log(n)).
+      if (--badAllowed == 0) {
+        heapSort(data, n, lessThan);
+        return;
+      }
+      if (nLeft >= ACE_SORTING_PDQ_SORT_THRESHOLD) {
+        pdqSortShuffle(data, nLeft);
+      }
+      if (nRight >= ACE_SORTING_PDQ_SORT_THRESHOLD) {
+        pdqSortShuffle(right, nRight);
+      }
+    } else if (alreadyPartitioned
+        && partialInsertionSort(data, nLeft, lessThan)
+        && partialInsertionSort(right, nRight, lessThan)) {
+      // No swaps were needed, so the input was probably sorted. Both sides
+      // are now sorted in linear time.
+      return;
+    }
+
+    if (nLeft < nRight) {
+      pdqSortRecursive(data, nLeft, lessThan, badAllowed, leftmost);
+      data = right;
+      n = nRight;
+      leftmost = false;
+    } else {
+      pdqSortRecursive(right, nRight, lessThan, badAllowed, false);
+      n = nLeft;
+    }
+  }
+
+  insertionSort(data, n, lessThan);
+}
+
+}
+
+/**
+ * Pattern-defeating quicksort. A quick sort which adapts to the patterns in
+ * the data:
+ *
+ *  * An array which is entirely in descending order is reversed in O(N).
+ *  * If a partition needed no swaps, the input is probably sorted, and a
+ *    partial insertion sort finishes both sides in O(N). It gives up after 8
+ *    element moves, so the cost is small when the guess is wrong.
+ *  * If the pivot is equal to the element just before the partition, the
+ *    elements equal to the pivot are grouped together and never partitioned
+ *    again.
+ *  * A highly unbalanced partition swaps a few elements to break the pattern.
+ *    After log2(N) unbalanced partitions, the remaining partition is sorted
+ *    using heapSort(), which guarantees O(N log(N)).
+ *
+ * Uses the branchless block partition of quickSortBlock() for integer and
+ * floating point types. The recursion only follows the smaller partition,
+ * so the stack usage is bounded by `O(log(N))`.
+ *
+ * Average complexity: O(n log(n))
+ * Worst complexity: O(n log(n))
+ * Best complexity: O(n) for sorted or reverse sorted data
+ *
+ * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename S = uint16_t>
+void pdqSort(T data[], S n) {
+  auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
+  pdqSort(data, n, lessThan);
+}
+
+/**
+ * Same as the 2-argument pdqSort() with the addition of a `lessThan` lambda
+ * expression or function.
+ *
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename F, typename S = uint16_t>
+void pdqSort(T data[], S n, F&& lessThan) {
+  if (n < 2) return;
+
+  // Reverse the array if it is entirely in non-increasing order. On random
+  // data, this stops after 1 or 2 comparisons.
+  S i = 1;
+  while (i < n && ! lessThan(data[i - 1], data[i])) i++;
+  if (i == n) {
+    internal::reverseRange(data, data + n);
+    return;
+  }
+
+  uint8_t badAllowed = 0;
+  for (S m = n; m > 1; m >>= 1) {
+    badAllowed++;
+  }
+  internal::pdqSortRecursive(data, n, lessThan, badAllowed, true);
+}
+
+}
+
+#endif
@@ -33,6 +33,8 @@ SOFTWARE.
 #define ACE_SORTING_QUICK_SORT_H
 
 #include "swap.h"
+#include "insertionSort.h"
+#include "sortingNetwork.h"
 
 #if ! defined(ACE_SORTING_DIRECT_QUICK_SORT)
   /**
@@ -48,6 +50,26 @@ SOFTWARE.
   #define ACE_SORTING_DIRECT_QUICK_SORT 1
 #endif
 
+#if ! defined(ACE_SORTING_QUICK_SORT_THRESHOLD)
+  /**
+   * Partitions with this many elements or fewer are sorted using
+   * insertionSort() instead of being partitioned further by the quickSortXxx()
+   * functions. Insertion Sort is faster than Quick Sort for small N, so a value
+   * of around 10 makes the quickSortXxx() functions faster on all boards, at
+   * the cost of the flash memory used by insertionSort(). The default of 1
+   * disables the cutoff and keeps the flash consumption as small as possible.
+   * (The `ACE_SORTING_QUICK_SORT_THRESHOLD > 1` checks in the code are
+   * compile-time constants, which allow the compiler to remove the
+   * insertionSort() code completely when the cutoff is disabled.)
+   * See examples/AutoBenchmark for the values tuned for each board.
+   *
+   * If ACE_SORTING_SIMD is enabled, the 2-argument quickSortXxx() functions
+   * sort the small partitions of 16-bit and 32-bit integers with the SIMD
+   * sorting network instead, which supports partitions of up to 32 elements.
+   */
+  #define ACE_SORTING_QUICK_SORT_THRESHOLD 1
+#endif
+
 namespace ace_sorting {
 
 /**
@@ -58,11 +80,17 @@ namespace ace_sorting {
  * See https://en.wikipedia.org/wiki/Quicksort
  *
  * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
  */
 #if ACE_SORTING_DIRECT_QUICK_SORT
-template <typename T>
-void quickSortMiddle(T data[], uint16_t n) {
-  if (n <= 1) return;
+template <typename T, typename S = uint16_t>
+void quickSortMiddle(T data[], S n) {
+  if (n <= ACE_SORTING_QUICK_SORT_THRESHOLD) {
+    if (ACE_SORTING_QUICK_SORT_THRESHOLD > 1) {
+      internal::SmallSort<T>::sort(data, n);
+    }
+    return;
+  }
 
   T pivot = data[n / 2];
   T* left = data;
@@ -80,12 +108,12 @@ void quickSortMiddle(T data[], uint16_t n) {
     }
   }
 
-  quickSortMiddle(data, right - data + 1);
-  quickSortMiddle(left, data + n - left);
+  quickSortMiddle(data, (S) (right - data + 1));
+  quickSortMiddle(left, (S) (data + n - left));
 }
 #else
-template <typename T>
-void quickSortMiddle(T data[], uint16_t n) {
+template <typename T, typename S = uint16_t>
+void quickSortMiddle(T data[], S n) {
   // This lambda expression does not perform any captures, so the compiler ought
   // to be able to optimize and inline the less-than expression. However, the
   // optimization does not seem to work, probably because of the recursive call
@@ -102,10 +130,14 @@ void quickSortMiddle(T data[], uint16_t n) {
  *
  * @tparam T type of data to sort
  * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
  */
-template <typename T, typename F>
-void quickSortMiddle(T data[], uint16_t n, F&& lessThan) {
-  if (n <= 1) return;
+template <typename T, typename F, typename S = uint16_t>
+void quickSortMiddle(T data[], S n, F&& lessThan) {
+  if (n <= ACE_SORTING_QUICK_SORT_THRESHOLD) {
+    if (ACE_SORTING_QUICK_SORT_THRESHOLD > 1) insertionSort(data, n, lessThan);
+    return;
+  }
 
   T pivot = data[n / 2];
   T* left = data;
@@ -123,8 +155,8 @@ void quickSortMiddle(T data[], uint16_t n, F&& lessThan) {
     }
   }
 
-  quickSortMiddle(data, right - data + 1, lessThan);
-  quickSortMiddle(left, data + n - left, lessThan);
+  quickSortMiddle(data, (S) (right - data + 1), lessThan);
+  quickSortMiddle(left, (S) (data + n - left), lessThan);
 }
 
 //-----------------------------------------------------------------------------
@@ -137,17 +169,23 @@ void quickSortMiddle(T data[], uint16_t n, F&& lessThan) {
  * See https://en.wikipedia.org/wiki/Quicksort
  *
  * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
  */
 #if ACE_SORTING_DIRECT_QUICK_SORT
-template <typename T>
-void quickSortMedian(T data[], uint16_t n) {
-  if (n <= 1) return;
+template <typename T, typename S = uint16_t>
+void quickSortMedian(T data[], S n) {
+  if (n <= ACE_SORTING_QUICK_SORT_THRESHOLD) {
+    if (ACE_SORTING_QUICK_SORT_THRESHOLD > 1) {
+      internal::SmallSort<T>::sort(data, n);
+    }
+    return;
+  }
 
   // Select the median of data[low], data[mid], and data[high] as the estimate
   // of the ideal pivot. Don't swap (low, mid) or (mid, high) (compare that
   // quickSortMedianSwapped()) to save flash memory. They will get swapped in
   // the partitioning while-loop below.
-  uint16_t mid = n / 2;
+  S mid = n / 2;
   T pivot = data[mid];
   if (data[n - 1] < data[0]) {
     swap(data[0], data[n - 1]);
@@ -173,12 +211,12 @@ void quickSortMedian(T data[], uint16_t n) {
     }
   }
 
-  quickSortMedian(data, right - data + 1);
-  quickSortMedian(left, data + n - left);
+  quickSortMedian(data, (S) (right - data + 1));
+  quickSortMedian(left, (S) (data + n - left));
 }
 #else
-template <typename T>
-void quickSortMedian(T data[], uint16_t n) {
+template <typename T, typename S = uint16_t>
+void quickSortMedian(T data[], S n) {
   // This lambda expression does not perform any captures, so the compiler will
   // optimize and inline the less-than expression.
   auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
@@ -192,16 +230,20 @@ void quickSortMedian(T data[], uint16_t n) {
  *
  * @tparam T type of data to sort
  * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
  */
-template <typename T, typename F>
-void quickSortMedian(T data[], uint16_t n, F&& lessThan) {
-  if (n <= 1) return;
+template <typename T, typename F, typename S = uint16_t>
+void quickSortMedian(T data[], S n, F&& lessThan) {
+  if (n <= ACE_SORTING_QUICK_SORT_THRESHOLD) {
+    if (ACE_SORTING_QUICK_SORT_THRESHOLD > 1) insertionSort(data, n, lessThan);
+    return;
+  }
 
   // Select the median of data[low], data[mid], and data[high] as the estimate
   // of the ideal pivot. Don't swap (low, mid) or (mid, high) (compare that
   // quickSortMedianSwapped()) to save flash memory. They will get swapped in
   // the partitioning while-loop below.
-  uint16_t mid = n / 2;
+  S mid = n / 2;
   T pivot = data[mid];
   if (lessThan(data[n - 1], data[0])) {
     swap(data[0], data[n - 1]);
@@ -227,8 +269,8 @@ void quickSortMedian(T data[], uint16_t n, F&& lessThan) {
     }
   }
 
-  quickSortMedian(data, right - data + 1, lessThan);
-  quickSortMedian(left, data + n - left, lessThan);
+  quickSortMedian(data, (S) (right - data + 1), lessThan);
+  quickSortMedian(left, (S) (data + n - left), lessThan);
 }
 
 //-----------------------------------------------------------------------------
@@ -241,15 +283,21 @@ void quickSortMedian(T data[], uint16_t n, F&& lessThan) {
  * calls, but runs slightly faster.
  *
  * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
  */
 #if ACE_SORTING_DIRECT_QUICK_SORT
-template <typename T>
-void quickSortMedianSwapped(T data[], uint16_t n) {
-  if (n <= 1) return;
+template <typename T, typename S = uint16_t>
+void quickSortMedianSwapped(T data[], S n) {
+  if (n <= ACE_SORTING_QUICK_SORT_THRESHOLD) {
+    if (ACE_SORTING_QUICK_SORT_THRESHOLD > 1) {
+      internal::SmallSort<T>::sort(data, n);
+    }
+    return;
+  }
 
   // Select the median of data[low], data[mid], and data[high] as the estimate
   // of the ideal pivot. In the process, the (low, mid, high) become sorted.
-  uint16_t mid = n / 2;
+  S mid = n / 2;
   T pivot = data[mid];
   if (data[n - 1] < data[0]) {
     swap(data[0], data[n - 1]);
@@ -277,12 +325,12 @@ void quickSortMedianSwapped(T data[], uint16_t n) {
     }
   }
 
-  quickSortMedianSwapped(data, right - data + 1);
-  quickSortMedianSwapped(left, data + n - left);
+  quickSortMedianSwapped(data, (S) (right - data + 1));
+  quickSortMedianSwapped(left, (S) (data + n - left));
 }
 #else
-template <typename T>
-void quickSortMedianSwapped(T data[], uint16_t n) {
+template <typename T, typename S = uint16_t>
+void quickSortMedianSwapped(T data[], S n) {
   // This lambda expression does not perform any captures, so the compiler will
   // optimize and inline the less-than expression.
   auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
@@ -296,14 +344,18 @@ void quickSortMedianSwapped(T data[], uint16_t n) {
  *
  * @tparam T type of data to sort
  * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
  */
-template <typename T, typename F>
-void quickSortMedianSwapped(T data[], uint16_t n, F&& lessThan) {
-  if (n <= 1) return;
+template <typename T, typename F, typename S = uint16_t>
+void quickSortMedianSwapped(T data[], S n, F&& lessThan) {
+  if (n <= ACE_SORTING_QUICK_SORT_THRESHOLD) {
+    if (ACE_SORTING_QUICK_SORT_THRESHOLD > 1) insertionSort(data, n, lessThan);
+    return;
+  }
 
   // Select the median of data[low], data[mid], and data[high] as the estimate
   // of the ideal pivot. In the process, the (low, mid, high) become sorted.
-  uint16_t mid = n / 2;
+  S mid = n / 2;
   T pivot = data[mid];
   if (lessThan(data[n - 1], data[0])) {
     swap(data[0], data[n - 1]);
@@ -331,8 +383,233 @@ void quickSortMedianSwapped(T data[], uint16_t n, F&& lessThan) {
     }
   }
 
-  quickSortMedianSwapped(data, right - data + 1, lessThan);
-  quickSortMedianSwapped(left, data + n - left, lessThan);
+  quickSortMedianSwapped(data, (S) (right - data + 1), lessThan);
+  quickSortMedianSwapped(left, (S) (data + n - left), lessThan);
+}
+
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Same as quickSortMedianSwapped() but uses an explicit fixed-size stack of
+ * pending partitions instead of recursion. The larger partition is pushed onto
+ * the stack, and the loop continues with the smaller partition, which is never
+ * more than half the size of its parent. So the stack can never hold more than
+ * log2(n) entries, which is at most the number of bits in `S` (e.g. 16 entries
+ * for `uint16_t`). The stack usage is fixed at compile time and does not depend
+ * on the input data.
+ *
+ * The 2-argument version always delegates to the 3-argument version because
+ * there is no recursion to prevent the compiler from inlining the lambda
+ * expression, so ACE_SORTING_DIRECT_QUICK_SORT does not apply.
+ *
+ * Average complexity: O(n log(n))
+ * See https://en.wikipedia.org/wiki/Quicksort
+ *
+ * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename S = uint16_t>
+void quickSortIterative(T data[], S n) {
+  auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
+  quickSortIterative(data, n, lessThan);
+}
+
+/**
+ * Same as the 2-argument quickSortIterative() with the addition of a
+ * `lessThan` lambda expression or function.
+ *
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename F, typename S = uint16_t>
+void quickSortIterative(T data[], S n, F&& lessThan) {
+  // Pending partitions, stored as (start, size) pairs.
+  const uint8_t kStackSize = sizeof(S) * 8;
+  T* stackData[kStackSize];
+  S stackN[kStackSize];
+  uint8_t top = 0;
+
+  while (true) {
+    if (n <= ACE_SORTING_QUICK_SORT_THRESHOLD) {
+      if (ACE_SORTING_QUICK_SORT_THRESHOLD > 1) {
+        insertionSort(data, n, lessThan);
+      }
+      if (top == 0) break;
+      top--;
+      data = stackData[top];
+      n = stackN[top];
+      continue;
+    }
+
+    // Select the median of data[low], data[mid], and data[high] as the
+    // estimate of the ideal pivot. In the process, the (low, mid, high) become
+    // sorted.
+    S mid = n / 2;
+    T pivot = data[mid];
+    if (lessThan(data[n - 1], data[0])) {
+      swap(data[0], data[n - 1]);
+    }
+    if (lessThan(pivot, data[0])) {
+      swap(data[0], data[mid]);
+    } else if (lessThan(data[n - 1], pivot)) {
+      swap(data[mid], data[n - 1]);
+    }
+    pivot = data[mid];
+
+    // We can skip the low and high because they are already sorted.
+    T* left = data + 1;
+    T* right = data + n - 2;
+
+    while (left <= right) {
+      if (lessThan(*left, pivot)) {
+        left++;
+      } else if (lessThan(pivot, *right)) {
+        right--;
+      } else {
+        swap(*left, *right);
+        left++;
+        right--;
+      }
+    }
+
+    // Push the larger partition, continue with the smaller partition.
+    S nLeft = right - data + 1;
+    S nRight = data + n - left;
+    if (nLeft < nRight) {
+      stackData[top] = left;
+      stackN[top] = nRight;
+      n = nLeft;
+    } else {
+      stackData[top] = data;
+      stackN[top] = nLeft;
+      data = left;
+      n = nRight;
+    }
+    top++;
+  }
+}
+
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Quick sort using a 3-way partition (Dijkstra's Dutch National Flag problem)
+ * which separates the elements into 3 groups: less than the pivot, equal to
+ * the pivot, and greater than the pivot. The elements equal to the pivot are
+ * already in their final position, so they are excluded from the recursion.
+ * This makes the algorithm much faster when the data contains many duplicate
+ * keys, approaching O(n) when there are only a few unique keys. The pivot is
+ * the median of the low, mid, and high elements, as in quickSortMedian(). The
+ * 3-way partition performs more swaps than the 2-way partition of the other
+ * quickSortXxx() functions, so it is slightly slower on data with mostly unique
+ * keys.
+ *
+ * Average complexity: O(n log(n)), O(n k) for k unique keys
+ * See https://en.wikipedia.org/wiki/Dutch_national_flag_problem
+ *
+ * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+#if ACE_SORTING_DIRECT_QUICK_SORT
+template <typename T, typename S = uint16_t>
+void quickSort3Way(T data[], S n) {
+  if (n <= ACE_SORTING_QUICK_SORT_THRESHOLD) {
+    if (ACE_SORTING_QUICK_SORT_THRESHOLD > 1) {
+      internal::SmallSort<T>::sort(data, n);
+    }
+    return;
+  }
+
+  // Select the median of data[low], data[mid], and data[high] as the estimate
+  // of the ideal pivot.
+  T pivot = data[n / 2];
+  if (data[n - 1] < data[0]) {
+    swap(data[0], data[n - 1]);
+  }
+  if (pivot < data[0]) {
+    pivot = data[0];
+  } else if (data[n - 1] < pivot) {
+    pivot = data[n - 1];
+  }
+
+  // Invariant: [data, lt) < pivot, [lt, i) == pivot, (gt, data + n) > pivot.
+  T* lt = data;
+  T* i = data;
+  T* gt = data + n - 1;
+  while (i <= gt) {
+    if (*i < pivot) {
+      swap(*lt, *i);
+      lt++;
+      i++;
+    } else if (pivot < *i) {
+      swap(*i, *gt);
+      gt--;
+    } else {
+      i++;
+    }
+  }
+
+  quickSort3Way(data, (S) (lt - data));
+  quickSort3Way(i, (S) (data + n - i));
+}
+#else
+template <typename T, typename S = uint16_t>
+void quickSort3Way(T data[], S n) {
+  // This lambda expression does not perform any captures, so the compiler will
+  // optimize and inline the less-than expression.
+  auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
+  quickSort3Way(data, n, lessThan);
+}
+#endif
+
+/**
+ * Same as the 2-argument quickSort3Way() with the addition of a `lessThan`
+ * lambda expression or function.
+ *
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename F, typename S = uint16_t>
+void quickSort3Way(T data[], S n, F&& lessThan) {
+  if (n <= ACE_SORTING_QUICK_SORT_THRESHOLD) {
+    if (ACE_SORTING_QUICK_SORT_THRESHOLD > 1) insertionSort(data, n, lessThan);
+    return;
+  }
+
+  // Select the median of data[low], data[mid], and data[high] as the estimate
+  // of the ideal pivot.
+  T pivot = data[n / 2];
+  if (lessThan(data[n - 1], data[0])) {
+    swap(data[0], data[n - 1]);
+  }
+  if (lessThan(pivot, data[0])) {
+    pivot = data[0];
+  } else if (lessThan(data[n - 1], pivot)) {
+    pivot = data[n - 1];
+  }
+
+  // Invariant: [data, lt) < pivot, [lt, i) == pivot, (gt, data + n) > pivot.
+  T* lt = data;
+  T* i = data;
+  T* gt = data + n - 1;
+  while (i <= gt) {
+    if (lessThan(*i, pivot)) {
+      swap(*lt, *i);
+      lt++;
+      i++;
+    } else if (lessThan(pivot, *i)) {
+      swap(*i, *gt);
+      gt--;
+    } else {
+      i++;
+    }
+  }
+
+  quickSort3Way(data, (S) (lt - data), lessThan);
+  quickSort3Way(i, (S) (data + n - i), lessThan);
 }
 
 }
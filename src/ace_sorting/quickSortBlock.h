@@ -0,0 +1,399 @@
+/*
+MIT License
+
+Copyright (c) 2021 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file quickSortBlock.h
+ *
+ * Quick sort using the branchless block partition of BlockQuicksort for
+ * arithmetic types.
+ * See "BlockQuicksort: How Branch Mispredictions don't affect Quicksort" by
+ * Stefan Edelkamp and Armin Weiss, https://arxiv.org/abs/1604.06697
+ */
+
+#ifndef ACE_SORTING_QUICK_SORT_BLOCK_H
+#define ACE_SORTING_QUICK_SORT_BLOCK_H
+
+#include <stdint.h> // uint8_t, uint16_t
+#include "swap.h"
+#include "insertionSort.h"
+
+#if ! defined(ACE_SORTING_QUICK_SORT_BLOCK_SIZE)
+  #if defined(ARDUINO_ARCH_AVR)
+    /**
+     * Number of elements examined in each block of the branchless partition.
+     * The partition uses 2 buffers of this many bytes on the stack. AVR
+     * processors have no branch predictor and little ram, so the default
+     * there is 16. Everywhere else, it is 64. Must be 255 or less.
+     */
+    #define ACE_SORTING_QUICK_SORT_BLOCK_SIZE 16
+  #else
+    #define ACE_SORTING_QUICK_SORT_BLOCK_SIZE 64
+  #endif
+#endif
+
+namespace ace_sorting {
+
+namespace internal {
+
+/**
+ * True if T is an integer or floating point type, whose comparisons and copies
+ * are cheap enough for the branchless partition. Same as
+ * std::is_arithmetic, which is not available on AVR.
+ */
+template <typename T> struct IsArithmetic { static const bool value = false; };
+template <> struct IsArithmetic<char> { static const bool value = true; };
+template <> struct IsArithmetic<signed char> {
+  static const bool value = true;
+};
+template <> struct IsArithmetic<unsigned char> {
+  static const bool value = true;
+};
+template <> struct IsArithmetic<short> { static const bool value = true; };
+template <> struct IsArithmetic<unsigned short> {
+  static const bool value = true;
+};
+template <> struct IsArithmetic<int> { static const bool value = true; };
+template <> struct IsArithmetic<unsigned int> {
+  static const bool value = true;
+};
+template <> struct IsArithmetic<long> { static const bool value = true; };
+template <> struct IsArithmetic<unsigned long> {
+  static const bool value = true;
+};
+template <> struct IsArithmetic<long long> { static const bool value = true; };
+template <> struct IsArithmetic<unsigned long long> {
+  static const bool value = true;
+};
+template <> struct IsArithmetic<float> { static const bool value = true; };
+template <> struct IsArithmetic<double> { static const bool value = true; };
+
+/** Sort the 3 elements a, b, c so that a <= b <= c. */
+template <typename T, typename F>
+void sort3(T& a, T& b, T& c, F&& lessThan) {
+  if (lessThan(b, a)) swap(a, b);
+  if (lessThan(c, b)) {
+    swap(b, c);
+    if (lessThan(b, a)) swap(a, b);
+  }
+}
+
+/**
+ * Move the median of data[0], data[n/2] and data[n-1] into data[0] to become
+ * the pivot of partitionRight(). Afterwards, data[n/2] <= data[0] <=
+ * data[n-1], so data[n-1] stops the scan from the left.
+ */
+template <typename T, typename F, typename S>
+void moveMedianToFirst(T data[], S n, F&& lessThan) {
+  sort3(data[n / 2], data[0], data[n - 1], lessThan);
+}
+
+/**
+ * Partition data[] around the pivot in data[0], using a classic Hoare scan
+ * which branches on every comparison. Returns the final position `p` of the
+ * pivot, such that data[0..p) < pivot <= data(p..n). The
+ * `alreadyPartitioned` flag is set if no elements had to be swapped.
+ *
+ * Requires n >= 3 and moveMedianToFirst().
+ */
+template <typename T, typename F, typename S>
+S partitionRight(T data[], S n, F&& lessThan, bool& alreadyPartitioned) {
+  T pivot = data[0];
+  S first = 0;
+  S last = n;
+
+  // Find the first element >= pivot. The median of 3 guarantees that one
+  // exists. Then find the last element < pivot. It does not necessarily exist
+  // if there was no element < pivot before `first`.
+  while (lessThan(data[++first], pivot)) {}
+  if (first == 1) {
+    while (first < last && ! lessThan(data[--last], pivot)) {}
+  } else {
+    while (! lessThan(data[--last], pivot)) {}
+  }
+
+  alreadyPartitioned = first >= last;
+  while (first < last) {
+    swap(data[first], data[last]);
+    while (lessThan(data[++first], pivot)) {}
+    while (! lessThan(data[--last], pivot)) {}
+  }
+
+  S pivotPos = first - 1;
+  data[0] = data[pivotPos];
+  data[pivotPos] = pivot;
+  return pivotPos;
+}
+
+/**
+ * Same as partitionRight() but without branches on the result of the
+ * comparisons. Each side scans a block of ACE_SORTING_QUICK_SORT_BLOCK_SIZE
+ * elements, recording the offsets of the elements which are on the wrong side
+ * of the pivot into a small buffer, by incrementing the buffer index with the
+ * result of the comparison. Then the elements at the offsets from the 2
+ * buffers are exchanged in a cyclic permutation.
+ *
+ * Derived from the partition_right_branchless() of pdqsort by Orson Peters.
+ */
+template <typename T, typename F, typename S>
+S partitionRightBranchless(
+    T data[], S n, F&& lessThan, bool& alreadyPartitioned) {
+  const uint8_t kBlockSize = ACE_SORTING_QUICK_SORT_BLOCK_SIZE;
+  T pivot = data[0];
+  T* first = data;
+  T* last = data + n;
+
+  while (lessThan(*++first, pivot)) {}
+  if (first - 1 == data) {
+    while (first < last && ! lessThan(*--last, pivot)) {}
+  } else {
+    while (! lessThan(*--last, pivot)) {}
+  }
+
+  alreadyPartitioned = first >= last;
+  if (! alreadyPartitioned) {
+    swap(*first, *last);
+    ++first;
+
+    uint8_t offsetsLeft[kBlockSize];
+    uint8_t offsetsRight[kBlockSize];
+    T* baseLeft = first;
+    T* baseRight = last;
+    uint8_t numLeft = 0;
+    uint8_t numRight = 0;
+    uint8_t startLeft = 0;
+    uint8_t startRight = 0;
+
+    while (first < last) {
+      // Determine how many of the unknown elements are scanned by each side.
+      // A side scans a new block only when its buffer is empty.
+      S numUnknown = last - first;
+      S leftSplit = (numLeft == 0)
+          ? ((numRight == 0) ? numUnknown / 2 : numUnknown)
+          : 0;
+      S rightSplit = (numRight == 0) ? (numUnknown - leftSplit) : 0;
+      if (leftSplit > kBlockSize) leftSplit = kBlockSize;
+      if (rightSplit > kBlockSize) rightSplit = kBlockSize;
+
+      // Record the offsets of the elements >= pivot on the left, and the
+      // elements < pivot on the right.
+      for (uint8_t i = 0; i < leftSplit; ) {
+        offsetsLeft[numLeft] = i++;
+        numLeft += ! lessThan(*first, pivot);
+        ++first;
+      }
+      for (uint8_t i = 0; i < rightSplit; ) {
+        offsetsRight[numRight] = ++i;
+        numRight += lessThan(*--last, pivot);
+      }
+
+      // Exchange the misplaced elements in pairs, as a cyclic permutation
+      // which needs 2 moves per pair instead of the 3 of a swap.
+      uint8_t num = (numLeft < numRight) ? numLeft : numRight;
+      if (num > 0) {
+        uint8_t* oLeft = offsetsLeft + startLeft;
+        uint8_t* oRight = offsetsRight + startRight;
+        T* l = baseLeft + oLeft[0];
+        T* r = baseRight - oRight[0];
+        T temp = *l;
+        *l = *r;
+        for (uint8_t i = 1; i < num; i++) {
+          l = baseLeft + oLeft[i];
+          *r = *l;
+          r = baseRight - oRight[i];
+          *l = *r;
+        }
+        *r = temp;
+      }
+      numLeft -= num;
+      numRight -= num;
+      startLeft += num;
+      startRight += num;
+
+      if (numLeft == 0) {
+        startLeft = 0;
+        baseLeft = first;
+      }
+      if (numRight == 0) {
+        startRight = 0;
+        baseRight = last;
+      }
+    }
+
+    // One of the buffers may still contain misplaced elements, which are
+    // moved next to the boundary between the 2 sides.
+    if (numLeft) {
+      uint8_t* oLeft = offsetsLeft + startLeft;
+      while (numLeft--) swap(*(baseLeft + oLeft[numLeft]), *--last);
+      first = last;
+    }
+    if (numRight) {
+      uint8_t* oRight = offsetsRight + startRight;
+      while (numRight--) {
+        swap(*(baseRight - oRight[numRight]), *first);
+        ++first;
+      }
+    }
+  }
+
+  T* pivotPos = first - 1;
+  data[0] = *pivotPos;
+  *pivotPos = pivot;
+  return pivotPos - data;
+}
+
+/**
+ * Move the elements equal to the pivot in data[0] to the front of data[],
+ * when the pivot is known to be the smallest element, and return the number
+ * of such elements (including the pivot). Used when the partition found no
+ * element smaller than the pivot, which happens mostly when there are many
+ * duplicate keys. Without it, an array of identical elements would be split
+ * into partitions of 0 and n-1 elements at every step, in O(n^2).
+ */
+template <typename T, typename F, typename S>
+S partitionEqual(T data[], S n, F&& lessThan) {
+  const T& pivot = data[0];
+  S numEqual = 1;
+  for (S i = 1; i < n; i++) {
+    if (! lessThan(pivot, data[i])) {
+      swap(data[i], data[numEqual]);
+      numEqual++;
+    }
+  }
+  return numEqual;
+}
+
+/** Select the partition function for type T. */
+template <typename T, bool BRANCHLESS = IsArithmetic<T>::value>
+struct BlockPartition {
+  template <typename F, typename S>
+  static S partition(T data[], S n, F&& lessThan, bool& alreadyPartitioned) {
+    return partitionRight(data, n, lessThan, alreadyPartitioned);
+  }
+};
+
+template <typename T>
+struct BlockPartition<T, true> {
+  template <typename F, typename S>
+  static S partition(T data[], S n, F&& lessThan, bool& alreadyPartitioned) {
+    return partitionRightBranchless(data, n, lessThan, alreadyPartitioned);
+  }
+};
+
+/**
+ * Body of quickSortBlock(), using the partition function `P::partition()`,
+ * so that quickSortSimd() can substitute its vectorized partition.
+ */
+template <typename P, typename T, typename F, typename S>
+void quickSortBlockIterative(T data[], S n, F&& lessThan) {
+  const uint8_t kThreshold = 16;
+  const uint8_t kStackSize = sizeof(S) * 8;
+  T* stackData[kStackSize];
+  S stackN[kStackSize];
+  uint8_t top = 0;
+
+  while (true) {
+    if (n <= kThreshold) {
+      insertionSort(data, n, lessThan);
+      if (top == 0) break;
+      top--;
+      data = stackData[top];
+      n = stackN[top];
+      continue;
+    }
+
+    moveMedianToFirst(data, n, lessThan);
+    bool alreadyPartitioned;
+    S pivotPos = P::partition(data, n, lessThan, alreadyPartitioned);
+
+    // The pivot is the smallest element, so skip over all the elements equal
+    // to it, instead of pushing an empty left partition.
+    if (pivotPos == 0) {
+      S numEqual = partitionEqual(data, n, lessThan);
+      data += numEqual;
+      n -= numEqual;
+      continue;
+    }
+
+    // Push the larger partition, continue with the smaller partition.
+    S nLeft = pivotPos;
+    S nRight = n - pivotPos - 1;
+    if (nLeft < nRight) {
+      stackData[top] = data + pivotPos + 1;
+      stackN[top] = nRight;
+      n = nLeft;
+    } else {
+      stackData[top] = data;
+      stackN[top] = nLeft;
+      data = data + pivotPos + 1;
+      n = nRight;
+    }
+    top++;
+  }
+}
+
+}
+
+/**
+ * Quick sort using the median of 3 as the pivot, and the block partition of
+ * BlockQuicksort for arithmetic types (integers and floating point numbers).
+ * The block partition records the comparison results into small buffers of
+ * offsets and exchanges the misplaced elements afterwards, so that the
+ * outcome of a comparison never decides a branch. On processors with branch
+ * prediction, this avoids the mispredictions of about half of the
+ * comparisons of the Hoare partition on random data. Other types use a
+ * classic Hoare partition.
+ *
+ * Non-recursive: the larger partition is pushed onto a fixed-size stack of
+ * pending partitions like quickSortIterative(), and partitions of 16 or fewer
+ * elements are sorted using insertionSort(). If the pivot turns out to be the
+ * smallest element, the elements equal to it are gathered and skipped, so
+ * that many duplicate keys are sorted in O(n log(n)).
+ *
+ * Average complexity: O(n log(n)), worst case O(n^2)
+ *
+ * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename S = uint16_t>
+void quickSortBlock(T data[], S n) {
+  auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
+  quickSortBlock(data, n, lessThan);
+}
+
+/**
+ * Same as the 2-argument quickSortBlock() with the addition of a `lessThan`
+ * lambda expression or function.
+ *
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename F, typename S = uint16_t>
+void quickSortBlock(T data[], S n, F&& lessThan) {
+  internal::quickSortBlockIterative<internal::BlockPartition<T>>(
+      data, n, lessThan);
+}
+
+}
+
+#endif
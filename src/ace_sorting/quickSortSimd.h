@@ -0,0 +1,416 @@
+/*
+MIT License
+
+Copyright (c) 2021 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file quickSortSimd.h
+ *
+ * Quick sort of 32-bit and 16-bit integers and floats using a vectorized
+ * partition on x86-64 processors with AVX2, selected at runtime so that the
+ * same binary runs on older processors. Other types and processors use
+ * quickSortBlock().
+ * See "Fast Quicksort Implementation Using AVX Instructions" by Shay Gueron
+ * and Vlad Krasnov, and "Vectorized and performance-portable Quicksort" by
+ * Mark Blacher, Joachim Giesen, Peter Sanders and Jan Wassenberg,
+ * https://arxiv.org/abs/2205.05982
+ */
+
+#ifndef ACE_SORTING_QUICK_SORT_SIMD_H
+#define ACE_SORTING_QUICK_SORT_SIMD_H
+
+#include <stdint.h> // uint8_t, uint16_t, int32_t, uint32_t
+#include "quickSortBlock.h"
+
+#if ! defined(ACE_SORTING_SIMD_PARTITION)
+  #if defined(__x86_64__) && defined(__GNUC__)
+    /**
+     * If set to 1, quickSortSimd() contains an AVX2 partition for `uint16_t`,
+     * `int32_t`, `uint32_t` and `float`, which is compiled using the `target`
+     * function attribute of GCC and Clang (so `-mavx2` is not required), and
+     * used only if the processor supports AVX2 at runtime. Enabled by default
+     * on x86-64. Set to 0 to always use quickSortBlock().
+     */
+    #define ACE_SORTING_SIMD_PARTITION 1
+  #else
+    #define ACE_SORTING_SIMD_PARTITION 0
+  #endif
+#endif
+
+#if ACE_SORTING_SIMD_PARTITION
+  #include <immintrin.h> // AVX2 intrinsics
+
+  /** Compile a function for AVX2, regardless of the compiler flags. */
+  #define ACE_SORTING_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+#endif
+
+namespace ace_sorting {
+
+namespace internal {
+
+/**
+ * Loads, stores and comparisons of 8 elements of type T in a 256-bit AVX2
+ * register of 8 x 32-bit lanes. Specialized for the types supported by the
+ * vectorized partition when ACE_SORTING_SIMD_PARTITION is enabled.
+ */
+template <typename T>
+struct Avx2Lanes {
+  /** True if avx2Partition() can partition type T. */
+  static const bool kEnabled = false;
+};
+
+#if ACE_SORTING_SIMD_PARTITION
+
+template <>
+struct Avx2Lanes<int32_t> {
+  static const bool kEnabled = true;
+
+  ACE_SORTING_TARGET_AVX2
+  static __m256i load(const int32_t* p) {
+    return _mm256_loadu_si256((const __m256i*) p);
+  }
+
+  ACE_SORTING_TARGET_AVX2
+  static void store(int32_t* p, __m256i v) {
+    _mm256_storeu_si256((__m256i*) p, v);
+  }
+
+  ACE_SORTING_TARGET_AVX2
+  static __m256i broadcast(int32_t x) { return _mm256_set1_epi32(x); }
+
+  /** Return a mask whose bit i is set if lane i of `v` < `pivot`. */
+  ACE_SORTING_TARGET_AVX2
+  static uint32_t lessThan(__m256i v, __m256i pivot) {
+    return _mm256_movemask_ps(
+        _mm256_castsi256_ps(_mm256_cmpgt_epi32(pivot, v)));
+  }
+};
+
+/**
+ * AVX2 has no unsigned comparison, so the sign bits of both operands are
+ * flipped, which maps the unsigned order onto the signed order.
+ */
+template <>
+struct Avx2Lanes<uint32_t> {
+  static const bool kEnabled = true;
+
+  ACE_SORTING_TARGET_AVX2
+  static __m256i load(const uint32_t* p) {
+    return _mm256_loadu_si256((const __m256i*) p);
+  }
+
+  ACE_SORTING_TARGET_AVX2
+  static void store(uint32_t* p, __m256i v) {
+    _mm256_storeu_si256((__m256i*) p, v);
+  }
+
+  ACE_SORTING_TARGET_AVX2
+  static __m256i broadcast(uint32_t x) { return _mm256_set1_epi32(x); }
+
+  ACE_SORTING_TARGET_AVX2
+  static uint32_t lessThan(__m256i v, __m256i pivot) {
+    __m256i sign = _mm256_set1_epi32(0x80000000);
+    return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(
+        _mm256_xor_si256(pivot, sign), _mm256_xor_si256(v, sign))));
+  }
+};
+
+/**
+ * The ordered comparison is false if either operand is NaN, so NaN is placed
+ * on the right side of the pivot, like the scalar `a < b`.
+ */
+template <>
+struct Avx2Lanes<float> {
+  static const bool kEnabled = true;
+
+  ACE_SORTING_TARGET_AVX2
+  static __m256i load(const float* p) {
+    return _mm256_castps_si256(_mm256_loadu_ps(p));
+  }
+
+  ACE_SORTING_TARGET_AVX2
+  static void store(float* p, __m256i v) {
+    _mm256_storeu_ps(p, _mm256_castsi256_ps(v));
+  }
+
+  ACE_SORTING_TARGET_AVX2
+  static __m256i broadcast(float x) {
+    return _mm256_castps_si256(_mm256_set1_ps(x));
+  }
+
+  ACE_SORTING_TARGET_AVX2
+  static uint32_t lessThan(__m256i v, __m256i pivot) {
+    return _mm256_movemask_ps(_mm256_cmp_ps(
+        _mm256_castsi256_ps(v), _mm256_castsi256_ps(pivot), _CMP_LT_OQ));
+  }
+};
+
+/**
+ * The 8 elements of `uint16_t` are zero-extended into 32-bit lanes, so that
+ * they can use the same permutations as the 32-bit types, and packed back
+ * into 16 bits when stored.
+ */
+template <>
+struct Avx2Lanes<uint16_t> {
+  static const bool kEnabled = true;
+
+  ACE_SORTING_TARGET_AVX2
+  static __m256i load(const uint16_t* p) {
+    return _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*) p));
+  }
+
+  ACE_SORTING_TARGET_AVX2
+  static void store(uint16_t* p, __m256i v) {
+    // packus works within each 128-bit half, so the 2 halves of 4 elements
+    // are gathered into the lower 128 bits afterwards.
+    __m256i packed = _mm256_packus_epi32(v, v);
+    packed = _mm256_permute4x64_epi64(packed, 0x08);
+    _mm_storeu_si128((__m128i*) p, _mm256_castsi256_si128(packed));
+  }
+
+  ACE_SORTING_TARGET_AVX2
+  static __m256i broadcast(uint16_t x) { return _mm256_set1_epi32(x); }
+
+  ACE_SORTING_TARGET_AVX2
+  static uint32_t lessThan(__m256i v, __m256i pivot) {
+    return _mm256_movemask_ps(
+        _mm256_castsi256_ps(_mm256_cmpgt_epi32(pivot, v)));
+  }
+};
+
+/**
+ * Table of the permutations which move the lanes whose bit is set in the
+ * 8-bit mask to the front, followed by the other lanes, each group in its
+ * original order. Each permutation is packed as 8 lane indexes of 4 bits,
+ * the first lane in the lowest bits, which keeps the table at 1 kB.
+ */
+struct Avx2Permutations {
+  static const uint32_t* permutations() {
+    static const uint32_t sPermutations[256] = {
+        0x76543210, 0x76543210, 0x76543201, 0x76543210, 0x76543102, 0x76543120,
+        0x76543021, 0x76543210, 0x76542103, 0x76542130, 0x76542031, 0x76542310,
+        0x76541032, 0x76541320, 0x76540321, 0x76543210, 0x76532104, 0x76532140,
+        0x76532041, 0x76532410, 0x76531042, 0x76531420, 0x76530421, 0x76534210,
+        0x76521043, 0x76521430, 0x76520431, 0x76524310, 0x76510432, 0x76514320,
+        0x76504321, 0x76543210, 0x76432105, 0x76432150, 0x76432051, 0x76432510,
+        0x76431052, 0x76431520, 0x76430521, 0x76435210, 0x76421053, 0x76421530,
+        0x76420531, 0x76425310, 0x76410532, 0x76415320, 0x76405321, 0x76453210,
+        0x76321054, 0x76321540, 0x76320541, 0x76325410, 0x76310542, 0x76315420,
+        0x76305421, 0x76354210, 0x76210543, 0x76215430, 0x76205431, 0x76254310,
+        0x76105432, 0x76154320, 0x76054321, 0x76543210, 0x75432106, 0x75432160,
+        0x75432061, 0x75432610, 0x75431062, 0x75431620, 0x75430621, 0x75436210,
+        0x75421063, 0x75421630, 0x75420631, 0x75426310, 0x75410632, 0x75416320,
+        0x75406321, 0x75463210, 0x75321064, 0x75321640, 0x75320641, 0x75326410,
+        0x75310642, 0x75316420, 0x75306421, 0x75364210, 0x75210643, 0x75216430,
+        0x75206431, 0x75264310, 0x75106432, 0x75164320, 0x75064321, 0x75643210,
+        0x74321065, 0x74321650, 0x74320651, 0x74326510, 0x74310652, 0x74316520,
+        0x74306521, 0x74365210, 0x74210653, 0x74216530, 0x74206531, 0x74265310,
+        0x74106532, 0x74165320, 0x74065321, 0x74653210, 0x73210654, 0x73216540,
+        0x73206541, 0x73265410, 0x73106542, 0x73165420, 0x73065421, 0x73654210,
+        0x72106543, 0x72165430, 0x72065431, 0x72654310, 0x71065432, 0x71654320,
+        0x70654321, 0x76543210, 0x65432107, 0x65432170, 0x65432071, 0x65432710,
+        0x65431072, 0x65431720, 0x65430721, 0x65437210, 0x65421073, 0x65421730,
+        0x65420731, 0x65427310, 0x65410732, 0x65417320, 0x65407321, 0x65473210,
+        0x65321074, 0x65321740, 0x65320741, 0x65327410, 0x65310742, 0x65317420,
+        0x65307421, 0x65374210, 0x65210743, 0x65217430, 0x65207431, 0x65274310,
+        0x65107432, 0x65174320, 0x65074321, 0x65743210, 0x64321075, 0x64321750,
+        0x64320751, 0x64327510, 0x64310752, 0x64317520, 0x64307521, 0x64375210,
+        0x64210753, 0x64217530, 0x64207531, 0x64275310, 0x64107532, 0x64175320,
+        0x64075321, 0x64753210, 0x63210754, 0x63217540, 0x63207541, 0x63275410,
+        0x63107542, 0x63175420, 0x63075421, 0x63754210, 0x62107543, 0x62175430,
+        0x62075431, 0x62754310, 0x61075432, 0x61754320, 0x60754321, 0x67543210,
+        0x54321076, 0x54321760, 0x54320761, 0x54327610, 0x54310762, 0x54317620,
+        0x54307621, 0x54376210, 0x54210763, 0x54217630, 0x54207631, 0x54276310,
+        0x54107632, 0x54176320, 0x54076321, 0x54763210, 0x53210764, 0x53217640,
+        0x53207641, 0x53276410, 0x53107642, 0x53176420, 0x53076421, 0x53764210,
+        0x52107643, 0x52176430, 0x52076431, 0x52764310, 0x51076432, 0x51764320,
+        0x50764321, 0x57643210, 0x43210765, 0x43217650, 0x43207651, 0x43276510,
+        0x43107652, 0x43176520, 0x43076521, 0x43765210, 0x42107653, 0x42176530,
+        0x42076531, 0x42765310, 0x41076532, 0x41765320, 0x40765321, 0x47653210,
+        0x32107654, 0x32176540, 0x32076541, 0x32765410, 0x31076542, 0x31765420,
+        0x30765421, 0x37654210, 0x21076543, 0x21765430, 0x20765431, 0x27654310,
+        0x10765432, 0x17654320, 0x07654321, 0x76543210,
+    };
+    return sPermutations;
+  }
+};
+
+/**
+ * Partition the 8 elements of `v`, storing the elements < pivot at
+ * `writeLeft` and the others ending at `writeRight`, then advance both
+ * pointers. The permuted vector is stored in full at both places, which
+ * overwrites 8 free slots on each side.
+ */
+template <typename T>
+ACE_SORTING_TARGET_AVX2
+inline void avx2PartitionStore(
+    __m256i v, __m256i pivot, T*& writeLeft, T*& writeRight) {
+  uint32_t mask = Avx2Lanes<T>::lessThan(v, pivot);
+  __m256i permutation = _mm256_srlv_epi32(
+      _mm256_set1_epi32(Avx2Permutations::permutations()[mask]),
+      _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28));
+  // vpermd uses only the lowest 3 bits of each index.
+  __m256i partitioned = _mm256_permutevar8x32_epi32(v, permutation);
+  uint8_t numLeft = _mm_popcnt_u32(mask);
+
+  Avx2Lanes<T>::store(writeLeft, partitioned);
+  writeLeft += numLeft;
+  Avx2Lanes<T>::store(writeRight - 8, partitioned);
+  writeRight -= 8 - numLeft;
+}
+
+/**
+ * Partition data[] around the pivot in data[0], 8 elements at a time, with
+ * the same result as partitionRight(): returns the final position `p` of the
+ * pivot, such that data[0..p) < pivot <= data(p..n).
+ *
+ * The first and last 8 elements are loaded into registers up front, which
+ * leaves 8 free slots at each end of the array. Each step loads the next 8
+ * elements from the end with fewer free slots, so that both ends always have
+ * at least 8 free slots for the full-width stores of avx2PartitionStore().
+ * Fewer than 8 remaining elements are partitioned one at a time, then the 2
+ * vectors loaded at the start fill the last 16 free slots.
+ *
+ * Requires n >= 17.
+ */
+template <typename T, typename S>
+ACE_SORTING_TARGET_AVX2
+S avx2Partition(T data[], S n) {
+  T pivotValue = data[0];
+  __m256i pivot = Avx2Lanes<T>::broadcast(pivotValue);
+  T* readLeft = data + 1;
+  T* readRight = data + n;
+  T* writeLeft = readLeft;
+  T* writeRight = readRight;
+
+  __m256i first = Avx2Lanes<T>::load(readLeft);
+  readLeft += 8;
+  readRight -= 8;
+  __m256i last = Avx2Lanes<T>::load(readRight);
+
+  while (readRight - readLeft >= 8) {
+    __m256i v;
+    if (readLeft - writeLeft <= writeRight - readRight) {
+      v = Avx2Lanes<T>::load(readLeft);
+      readLeft += 8;
+    } else {
+      readRight -= 8;
+      v = Avx2Lanes<T>::load(readRight);
+    }
+    avx2PartitionStore(v, pivot, writeLeft, writeRight);
+  }
+
+  while (readLeft < readRight) {
+    T x = (readLeft - writeLeft <= writeRight - readRight)
+        ? *readLeft++
+        : *--readRight;
+    if (x < pivotValue) {
+      *writeLeft++ = x;
+    } else {
+      *--writeRight = x;
+    }
+  }
+
+  avx2PartitionStore(first, pivot, writeLeft, writeRight);
+  avx2PartitionStore(last, pivot, writeLeft, writeRight);
+
+  T* pivotPos = writeLeft - 1;
+  data[0] = *pivotPos;
+  *pivotPos = pivotValue;
+  return pivotPos - data;
+}
+
+/** Return true if the processor supports the instructions of avx2Partition. */
+inline bool hasAvx2() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+}
+
+/**
+ * Partition policy of quickSortBlockIterative() which uses avx2Partition().
+ * The `lessThan` argument is ignored, because the vector comparisons always
+ * use the natural `<` order of T.
+ */
+template <typename T>
+struct Avx2Partition {
+  template <typename F, typename S>
+  static S partition(T data[], S n, F&& /*lessThan*/,
+      bool& alreadyPartitioned) {
+    alreadyPartitioned = false;
+    return avx2Partition(data, n);
+  }
+};
+
+#endif
+
+/** Select the implementation of quickSortSimd() for type T. */
+template <typename T, bool SIMD = Avx2Lanes<T>::kEnabled>
+struct QuickSortSimd {
+  template <typename S>
+  static void sort(T data[], S n) {
+    quickSortBlock(data, n);
+  }
+};
+
+#if ACE_SORTING_SIMD_PARTITION
+template <typename T>
+struct QuickSortSimd<T, true> {
+  template <typename S>
+  static void sort(T data[], S n) {
+    if (hasAvx2()) {
+      auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
+      quickSortBlockIterative<Avx2Partition<T>>(data, n, lessThan);
+    } else {
+      quickSortBlock(data, n);
+    }
+  }
+};
+#endif
+
+}
+
+/**
+ * Quick sort using a vectorized partition for `uint16_t`, `int32_t`,
+ * `uint32_t` and `float` on x86-64 processors which support AVX2. Each step
+ * of the partition compares 8 elements against the pivot in a single
+ * instruction, and stores the elements smaller than the pivot on the left and
+ * the others on the right using a permutation from a lookup table, without
+ * any branch on the comparisons. The support for AVX2 is checked at runtime.
+ *
+ * Otherwise (other types, other processors, or ACE_SORTING_SIMD_PARTITION
+ * set to 0), this is the same as quickSortBlock(). There is no version with a
+ * `lessThan` argument, because the vector instructions can only compare
+ * using the natural order of T.
+ *
+ * Average complexity: O(n log(n)), worst case O(n^2)
+ *
+ * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename S = uint16_t>
+void quickSortSimd(T data[], S n) {
+  internal::QuickSortSimd<T>::sort(data, n);
+}
+
+}
+
+#endif
@@ -0,0 +1,208 @@
+/*
+MIT License
+
+Copyright (c) 2021 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file radixSort.h
+ *
+ * Least significant digit (LSD) radix sort for integer and floating point
+ * keys, using a scratch buffer supplied by the caller.
+ * See https://en.wikipedia.org/wiki/Radix_sort
+ */
+
+#ifndef ACE_SORTING_RADIX_SORT_H
+#define ACE_SORTING_RADIX_SORT_H
+
+#include <stdint.h> // uint8_t, uint16_t, uint32_t, uint64_t
+#include <string.h> // memcpy()
+
+#if ! defined(ACE_SORTING_RADIX_SORT_BITS)
+  #if defined(ARDUINO_ARCH_AVR)
+    /**
+     * Number of bits of the key sorted in each pass of radixSort(). Each pass
+     * uses an array of (1 << ACE_SORTING_RADIX_SORT_BITS) counters on the
+     * stack. The default on AVR is 4 (16 counters) to conserve ram. Everywhere
+     * else, it is 8 (256 counters) which needs half as many passes.
+     */
+    #define ACE_SORTING_RADIX_SORT_BITS 4
+  #else
+    #define ACE_SORTING_RADIX_SORT_BITS 8
+  #endif
+#endif
+
+namespace ace_sorting {
+
+namespace internal {
+
+/** Unsigned integer type with the given number of bytes. */
+template <uint8_t SIZE> struct UnsignedInt {};
+template <> struct UnsignedInt<1> { typedef uint8_t type; };
+template <> struct UnsignedInt<2> { typedef uint16_t type; };
+template <> struct UnsignedInt<4> { typedef uint32_t type; };
+template <> struct UnsignedInt<8> { typedef uint64_t type; };
+
+/** Remove the reference and const qualifiers. Same as std::decay. */
+template <typename T> struct RemoveConstRef { typedef T type; };
+template <typename T> struct RemoveConstRef<T&> { typedef T type; };
+template <typename T> struct RemoveConstRef<const T> { typedef T type; };
+template <typename T> struct RemoveConstRef<const T&> { typedef T type; };
+
+/**
+ * Convert a key of type K into an unsigned integer whose natural ordering is
+ * the same as the ordering of K. Unsigned integers are unchanged. Signed
+ * integers have their sign bit flipped, so that negative numbers are ordered
+ * before positive numbers.
+ *
+ * @tparam K integer type of the key
+ */
+template <typename K>
+struct RadixKey {
+  typedef typename UnsignedInt<sizeof(K)>::type type;
+
+  static type toUnsigned(K key) {
+    const bool isSigned = (K) -1 < (K) 1;
+    const type signBit = (type) 1 << (sizeof(K) * 8 - 1);
+    return isSigned ? (type) ((type) key ^ signBit) : (type) key;
+  }
+};
+
+/**
+ * Convert an IEEE 754 floating point key into an unsigned integer. Positive
+ * numbers have their sign bit set, so that they are ordered after the negative
+ * numbers. Negative numbers have all their bits inverted, so that the larger
+ * magnitudes are ordered first. NaN values are ordered at the ends.
+ *
+ * @tparam F floating point type of the key
+ */
+template <typename F>
+struct RadixFloatKey {
+  typedef typename UnsignedInt<sizeof(F)>::type type;
+
+  static type toUnsigned(F key) {
+    const type signBit = (type) 1 << (sizeof(F) * 8 - 1);
+    type bits;
+    memcpy(&bits, &key, sizeof(bits));
+    return (bits & signBit) ? (type) ~bits : (type) (bits | signBit);
+  }
+};
+
+template <> struct RadixKey<float> : RadixFloatKey<float> {};
+template <> struct RadixKey<double> : RadixFloatKey<double> {};
+
+}
+
+/**
+ * LSD radix sort. Not a comparison sort: each pass distributes the elements
+ * into buckets using ACE_SORTING_RADIX_SORT_BITS bits of the key, starting from
+ * the least significant bits, and copies them between `data` and `buffer`. The
+ * caller must supply a `buffer` of at least `n` elements. A pass is skipped if
+ * all the keys have the same digit, so small values stored in a large type
+ * (e.g. 10-bit ADC values in a `uint16_t`) need fewer passes.
+ *
+ * Supports unsigned and signed integers, `float` and `double`.
+ *
+ * Complexity: O(n k) where k is the number of passes, e.g. 2 for `uint16_t`
+ * and 4 for `uint32_t` with 8-bit digits.
+ * Stable sort: Yes
+ *
+ * @tparam T type of data to sort, an integer or floating point type
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename S = uint16_t>
+void radixSort(T data[], S n, T buffer[]) {
+  auto&& keyOf = [](const T& a) -> T { return a; };
+  radixSort(data, n, buffer, keyOf);
+}
+
+/**
+ * Same as the 3-argument radixSort() but sorts elements of any type `T` using
+ * the integer or floating point key returned by the `keyOf` lambda expression
+ * or function. The sort is stable, so records can be sorted by multiple keys
+ * using multiple passes.
+ *
+ * Unlike the other xxxSort() functions, the 4th argument is not a `lessThan`
+ * predicate, because radix sort does not compare elements. To sort in reverse
+ * order, return a key which is reversed, e.g. the bitwise inverse of an
+ * unsigned key.
+ *
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns the key of an
+ *    element
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename F, typename S = uint16_t>
+void radixSort(T data[], S n, T buffer[], F&& keyOf) {
+  typedef typename internal::RemoveConstRef<decltype(keyOf(data[0]))>::type K;
+  typedef internal::RadixKey<K> RadixKey;
+  typedef typename RadixKey::type U;
+
+  const uint8_t kBits = ACE_SORTING_RADIX_SORT_BITS;
+  const uint16_t kNumBuckets = (uint16_t) 1 << kBits;
+  const U kMask = kNumBuckets - 1;
+  S counts[kNumBuckets];
+
+  if (n <= 1) return;
+
+  T* src = data;
+  T* dst = buffer;
+  for (uint8_t shift = 0; shift < sizeof(U) * 8; shift += kBits) {
+    for (uint16_t i = 0; i < kNumBuckets; i++) {
+      counts[i] = 0;
+    }
+    for (S i = 0; i < n; i++) {
+      counts[(RadixKey::toUnsigned(keyOf(src[i])) >> shift) & kMask]++;
+    }
+
+    // Skip this pass if every element is in the same bucket.
+    if (counts[(RadixKey::toUnsigned(keyOf(src[0])) >> shift) & kMask] == n) {
+      continue;
+    }
+
+    // Convert the counts into the starting position of each bucket.
+    S sum = 0;
+    for (uint16_t i = 0; i < kNumBuckets; i++) {
+      S count = counts[i];
+      counts[i] = sum;
+      sum += count;
+    }
+
+    for (S i = 0; i < n; i++) {
+      dst[counts[(RadixKey::toUnsigned(keyOf(src[i])) >> shift) & kMask]++] =
+          src[i];
+    }
+
+    T* temp = src;
+    src = dst;
+    dst = temp;
+  }
+
+  // If there was an odd number of passes, the result is in buffer.
+  if (src != data) {
+    for (S i = 0; i < n; i++) {
+      data[i] = src[i];
+    }
+  }
+}
+
+}
+
+#endif
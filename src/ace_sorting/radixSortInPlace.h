@@ -0,0 +1,183 @@
+/*
+MIT License
+
+Copyright (c) 2021 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file radixSortInPlace.h
+ *
+ * In-place most significant digit (MSD) radix sort, also known as American flag
+ * sort, for integer and floating point keys.
+ * See https://en.wikipedia.org/wiki/American_flag_sort
+ */
+
+#ifndef ACE_SORTING_RADIX_SORT_IN_PLACE_H
+#define ACE_SORTING_RADIX_SORT_IN_PLACE_H
+
+#include "swap.h"
+#include "insertionSort.h"
+#include "radixSort.h" // RadixKey, ACE_SORTING_RADIX_SORT_BITS
+
+#if ! defined(ACE_SORTING_RADIX_SORT_THRESHOLD)
+  /**
+   * Buckets smaller than or equal to this size are sorted using
+   * insertionSort() by radixSortInPlace(), instead of being distributed
+   * further using the next digit.
+   */
+  #define ACE_SORTING_RADIX_SORT_THRESHOLD 16
+#endif
+
+namespace ace_sorting {
+
+namespace internal {
+
+/**
+ * Recursive part of radixSortInPlace(). Distributes the elements into buckets
+ * using the digit at `shift`, by following the permutation cycles (McIlroy,
+ * Bostic and McIlroy, "Engineering Radix Sort", 1993), then sorts each bucket
+ * using the next lower digit. The recursion depth is limited by the number of
+ * digits in the key.
+ *
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns the key of an
+ *    element
+ * @tparam S type of the index into data[]
+ */
+template <typename T, typename F, typename S>
+void radixSortInPlaceRecursive(T data[], S n, uint8_t shift, F&& keyOf) {
+  typedef typename RemoveConstRef<decltype(keyOf(data[0]))>::type K;
+  typedef RadixKey<K> RadixKey;
+  typedef typename RadixKey::type U;
+
+  const uint8_t kBits = ACE_SORTING_RADIX_SORT_BITS;
+  const uint16_t kNumBuckets = (uint16_t) 1 << kBits;
+  const U kMask = kNumBuckets - 1;
+  S counts[kNumBuckets];
+  S ends[kNumBuckets];
+
+  while (true) {
+    if (n <= ACE_SORTING_RADIX_SORT_THRESHOLD) {
+      insertionSort(data, n, [&keyOf](const T& a, const T& b) {
+        return RadixKey::toUnsigned(keyOf(a)) < RadixKey::toUnsigned(keyOf(b));
+      });
+      return;
+    }
+
+    for (uint16_t i = 0; i < kNumBuckets; i++) {
+      counts[i] = 0;
+    }
+    for (S i = 0; i < n; i++) {
+      counts[(RadixKey::toUnsigned(keyOf(data[i])) >> shift) & kMask]++;
+    }
+
+    // If every element has the same digit, continue with the next digit
+    // without recursion.
+    if (counts[(RadixKey::toUnsigned(keyOf(data[0])) >> shift) & kMask] == n) {
+      if (shift == 0) return;
+      shift -= kBits;
+      continue;
+    }
+
+    // Position after the last element of each bucket.
+    S sum = 0;
+    for (uint16_t i = 0; i < kNumBuckets; i++) {
+      sum += counts[i];
+      ends[i] = sum;
+    }
+
+    // Move each element into its bucket, filling each bucket from its end. When
+    // the cycle starting at data[i] returns to i, the bucket that starts at i
+    // is complete, so skip over it.
+    for (S i = 0; i < n; ) {
+      T value = data[i];
+      uint16_t bucket;
+      while (true) {
+        bucket = (RadixKey::toUnsigned(keyOf(value)) >> shift) & kMask;
+        if (--ends[bucket] <= i) break;
+        swap(value, data[ends[bucket]]);
+      }
+      data[i] = value;
+      i += counts[bucket];
+    }
+
+    if (shift == 0) return;
+
+    T* bucketStart = data;
+    for (uint16_t i = 0; i < kNumBuckets; i++) {
+      if (counts[i] > 1) {
+        radixSortInPlaceRecursive(
+            bucketStart, counts[i], (uint8_t) (shift - kBits), keyOf);
+      }
+      bucketStart += counts[i];
+    }
+    return;
+  }
+}
+
+}
+
+/**
+ * In-place MSD radix sort (American flag sort). Unlike radixSort(), this does
+ * not need a scratch buffer. The elements are distributed into buckets using
+ * the most significant ACE_SORTING_RADIX_SORT_BITS bits of the key, by swapping
+ * them along the permutation cycles. Then each bucket is sorted recursively
+ * using the next digit. Buckets smaller than or equal to
+ * ACE_SORTING_RADIX_SORT_THRESHOLD are sorted with insertionSort().
+ *
+ * Supports unsigned and signed integers, `float` and `double`.
+ *
+ * Complexity: O(n k) where k is the number of digits in the key
+ * Stable sort: No
+ *
+ * @tparam T type of data to sort, an integer or floating point type
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename S = uint16_t>
+void radixSortInPlace(T data[], S n) {
+  auto&& keyOf = [](const T& a) -> T { return a; };
+  radixSortInPlace(data, n, keyOf);
+}
+
+/**
+ * Same as the 2-argument radixSortInPlace() but sorts elements of any type `T`
+ * using the integer or floating point key returned by the `keyOf` lambda
+ * expression or function. As with radixSort(), the 3rd argument is not a
+ * `lessThan` predicate.
+ *
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns the key of an
+ *    element
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename F, typename S = uint16_t>
+void radixSortInPlace(T data[], S n, F&& keyOf) {
+  typedef typename internal::RemoveConstRef<decltype(keyOf(data[0]))>::type K;
+  const uint8_t kKeyBits = sizeof(K) * 8;
+  const uint8_t kBits = ACE_SORTING_RADIX_SORT_BITS;
+
+  // Shift of the most significant digit.
+  const uint8_t shift = (kKeyBits - 1) / kBits * kBits;
+  internal::radixSortInPlaceRecursive(data, n, shift, keyOf);
+}
+
+}
+
+#endif
@@ -52,21 +52,22 @@ namespace ace_sorting {
  * See https://en.wikipedia.org/wiki/Selection_sort
  *
  * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
  */
 #if ACE_SORTING_DIRECT_SELECTION_SORT
-template <typename T>
-void selectionSort(T data[], uint16_t n) {
-  for (uint16_t i = 0; i < n; i++) {
+template <typename T, typename S = uint16_t>
+void selectionSort(T data[], S n) {
+  for (S i = 0; i < n; i++) {
 
     // Loop to find the smallest element.
-    uint16_t iSmallest = i;
+    S iSmallest = i;
     T smallest = data[i];
 
     // Starting the loop with 'j = i + 1' increases flash usage on AVR by 12
     // bytes. But it does not reduce the execution time signficantly, because
     // the (i + 1) will be done anyway by the j++ in the loop. So the only thing
     // we save is a single redundant 'smallest < smallest' comparison.
-    for (uint16_t j = i; j < n; j++) {
+    for (S j = i; j < n; j++) {
       if (data[j] < smallest) {
         iSmallest = j;
         smallest = data[j];
@@ -85,8 +86,8 @@ void selectionSort(T data[], uint16_t n) {
   }
 }
 #else
-template <typename T>
-void selectionSort(T data[], uint16_t n) {
+template <typename T, typename S = uint16_t>
+void selectionSort(T data[], S n) {
   // This lambda expression does not perform any captures, so the compiler will
   // optimize and inline the less-than expression.
   auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
@@ -100,20 +101,21 @@ void selectionSort(T data[], uint16_t n) {
  *
  * @tparam T type of data to sort
  * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
  */
-template <typename T, typename F>
-void selectionSort(T data[], uint16_t n, F&& lessThan) {
-  for (uint16_t i = 0; i < n; i++) {
+template <typename T, typename F, typename S = uint16_t>
+void selectionSort(T data[], S n, F&& lessThan) {
+  for (S i = 0; i < n; i++) {
 
     // Loop to find the smallest element.
-    uint16_t iSmallest = i;
+    S iSmallest = i;
     T smallest = data[i];
 
     // Starting the loop with 'j = i + 1' increases flash usage on AVR by 12
     // bytes. But it does not reduce the execution time signficantly, because
     // the (i + 1) will be done anyway by the j++ in the loop. So the only thing
     // we save is a single redundant 'smallest < smallest' comparison.
-    for (uint16_t j = i; j < n; j++) {
+    for (S j = i; j < n; j++) {
       if (lessThan(data[j], smallest)) {
         iSmallest = j;
         smallest = data[j];
@@ -50,20 +50,21 @@ namespace ace_sorting {
  * See https://en.wikipedia.org/wiki/Shellsort
  *
  * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
  */
 #if ACE_SORTING_DIRECT_SHELL_SORT
-template <typename T>
-void shellSortClassic(T data[], uint16_t n) {
-  uint16_t gap = n;
+template <typename T, typename S = uint16_t>
+void shellSortClassic(T data[], S n) {
+  S gap = n;
   while (gap > 1) {
     gap /= 2;
 
     // Do insertion sort of each sub-array separated by gap.
-    for (uint16_t i = gap; i < n; i++) {
+    for (S i = gap; i < n; i++) {
       T temp = data[i];
 
       // Shift one slot to the right.
-      uint16_t j;
+      S j;
       for (j = i; j >= gap; j -= gap) {
         if (data[j - gap] <= temp) break;
         data[j] = data[j - gap];
@@ -78,8 +79,8 @@ void shellSortClassic(T data[], uint16_t n) {
   }
 }
 #else
-template <typename T>
-void shellSortClassic(T data[], uint16_t n) {
+template <typename T, typename S = uint16_t>
+void shellSortClassic(T data[], S n) {
   // This lambda expression does not perform any captures, so the compiler will
   // optimize and inline the less-than expression.
   auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
@@ -94,19 +95,20 @@ void shellSortClassic(T data[], uint16_t n) {
  *
  * @tparam T type of data to sort
  * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
  */
-template <typename T, typename F>
-void shellSortClassic(T data[], uint16_t n, F&& lessThan) {
-  uint16_t gap = n;
+template <typename T, typename F, typename S = uint16_t>
+void shellSortClassic(T data[], S n, F&& lessThan) {
+  S gap = n;
   while (gap > 1) {
     gap /= 2;
 
     // Do insertion sort of each sub-array separated by gap.
-    for (uint16_t i = gap; i < n; i++) {
+    for (S i = gap; i < n; i++) {
       T temp = data[i];
 
       // Shift one slot to the right.
-      uint16_t j;
+      S j;
       for (j = i; j >= gap; j -= gap) {
         // The following is equivalent to: (data[j - gap] <= temp)
         if (! lessThan(temp, data[j - gap])) break;
@@ -129,26 +131,27 @@ void shellSortClassic(T data[], uint16_t n, F&& lessThan) {
  * Average complexity: Between O(n^1.3) to O(n^1.5)
  *
  * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
  */
 #if ACE_SORTING_DIRECT_SHELL_SORT
-template <typename T>
-void shellSortKnuth(T data[], uint16_t n) {
+template <typename T, typename S = uint16_t>
+void shellSortKnuth(T data[], S n) {
   // Calculate the largest gap using Knuth's formula. If n is a compile-time
   // constant and relatively "small" (observed to be true at least up to 100),
   // the compiler will precalculate the loop below and replace it with a
   // compile-time constant.
-  uint16_t gap = 1;
+  S gap = 1;
   while (gap < n / 3) {
     gap = gap * 3 + 1;
   }
 
   while (gap > 0) {
     // Do insertion sort of each sub-array separated by gap.
-    for (uint16_t i = gap; i < n; i++) {
+    for (S i = gap; i < n; i++) {
       T temp = data[i];
 
       // Shift one slot to the right.
-      uint16_t j;
+      S j;
       for (j = i; j >= gap; j -= gap) {
         if (data[j - gap] <= temp) break;
         data[j] = data[j - gap];
@@ -165,8 +168,8 @@ void shellSortKnuth(T data[], uint16_t n) {
   }
 }
 #else
-template <typename T>
-void shellSortKnuth(T data[], uint16_t n) {
+template <typename T, typename S = uint16_t>
+void shellSortKnuth(T data[], S n) {
   // This lambda expression does not perform any captures, so the compiler will
   // optimize and inline the less-than expression.
   auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
@@ -180,21 +183,22 @@ void shellSortKnuth(T data[], uint16_t n) {
  *
  * @tparam T type of data to sort
  * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
  */
-template <typename T, typename F>
-void shellSortKnuth(T data[], uint16_t n, F&& lessThan) {
-  uint16_t gap = 1;
+template <typename T, typename F, typename S = uint16_t>
+void shellSortKnuth(T data[], S n, F&& lessThan) {
+  S gap = 1;
   while (gap < n / 3) {
     gap = gap * 3 + 1;
   }
 
   while (gap > 0) {
     // Do insertion sort of each sub-array separated by gap.
-    for (uint16_t i = gap; i < n; i++) {
+    for (S i = gap; i < n; i++) {
       T temp = data[i];
 
       // Shift one slot to the right.
-      uint16_t j;
+      S j;
       for (j = i; j >= gap; j -= gap) {
         // The following is equivalent to: (data[j - gap] <= temp)
         if (! lessThan(temp, data[j - gap])) break;
@@ -214,39 +218,98 @@ void shellSortKnuth(T data[], uint16_t n, F&& lessThan) {
 
 //-----------------------------------------------------------------------------
 
+namespace internal {
+
+/** Select type A if COND is true, otherwise B. Same as std::conditional. */
+template <bool COND, typename A, typename B>
+struct Conditional {
+  typedef A type;
+};
+
+template <typename A, typename B>
+struct Conditional<false, A, B> {
+  typedef B type;
+};
+
+/**
+ * Experimentally observed ideal gaps for shellSortTokuda(), for index types
+ * which are 16-bits or smaller. See https://en.wikipedia.org/wiki/Shellsort and
+ * https://oeis.org/A108870.
+ */
+template <bool WIDE>
+struct TokudaGaps {
+  typedef uint16_t GapType;
+
+  static const uint16_t kNumGaps = 13;
+
+  static const uint16_t* gaps() {
+    static const uint16_t sGaps[kNumGaps] = {
+        1, 4, 9, 20, 46, 103, 233, 525, 1182, 2660, 5985, 13467, 30301,
+    };
+    return sGaps;
+  }
+};
+
+/**
+ * Tokuda gaps for index types larger than 16-bits. The table is extended up to
+ * the largest gap that fits in a `uint32_t`. Keeping this separate from the
+ * 16-bit table prevents 8-bit processors from paying for the larger table in
+ * static RAM when the default `uint16_t` index is used.
+ */
+template <>
+struct TokudaGaps<true> {
+  typedef uint32_t GapType;
+
+  static const uint16_t kNumGaps = 27;
+
+  static const uint32_t* gaps() {
+    static const uint32_t sGaps[kNumGaps] = {
+        1, 4, 9, 20, 46, 103, 233, 525, 1182, 2660, 5985, 13467, 30301,
+        68178, 153401, 345152, 776591, 1747331, 3931496, 8845866, 19903198,
+        44782196, 100759940, 226709866, 510097200, 1147718700, 2582367076,
+    };
+    return sGaps;
+  }
+};
+
+}
+
 /**
  * Shell sort using gap sizes empirically determined by Tokuda. See
  * https://en.wikipedia.org/wiki/Shellsort and https://oeis.org/A108870.
  * Average complexity: Between O(n^1.3) to O(n^1.5)
  *
  * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
  */
 #if ACE_SORTING_DIRECT_SHELL_SORT
-template<typename T>
-void shellSortTokuda(T data[], const uint16_t n)
-{
-  // Experimentally observed ideal gaps.
-  // https://en.wikipedia.org/wiki/Shellsort
-  // https://oeis.org/A108870
-  static const uint16_t sGaps[] = {
-      1, 4, 9, 20, 46, 103, 233, 525, 1182, 2660, 5985, 13467, 30301,
-  };
-  const uint16_t nGaps = sizeof(sGaps) / sizeof(uint16_t);
-
-  // Find the starting gap.
+template <typename T, typename S = uint16_t>
+void shellSortTokuda(T data[], S n) {
+  // Select the gap table which is wide enough for the index type S.
+  typedef internal::TokudaGaps<(sizeof(S) > 2)> Gaps;
+  typedef typename Gaps::GapType GapType;
+  const GapType* const sGaps = Gaps::gaps();
+  const uint16_t nGaps = Gaps::kNumGaps;
+
+  // Find the starting gap. Compare using the wider of GapType and S so that
+  // neither side is truncated, even if S is a signed type.
+  typedef typename internal::Conditional<
+      (sizeof(S) > sizeof(GapType)), S, GapType>::type CompareType;
   uint16_t iGap;
-  for (iGap = 0; sGaps[iGap] < n && iGap < nGaps; iGap++) {}
+  for (iGap = 0;
+      iGap < nGaps && (CompareType) sGaps[iGap] < (CompareType) n;
+      iGap++) {}
   if (iGap != 0) iGap--;
 
   while (true) {
-    uint16_t gap = sGaps[iGap];
+    S gap = sGaps[iGap];
 
     // Do insertion sort of each sub-array separated by gap.
-    for (uint16_t i = gap; i < n; i++) {
+    for (S i = gap; i < n; i++) {
       T temp = data[i];
 
       // Shift one slot to the right.
-      uint16_t j;
+      S j;
       for (j = i; j >= gap; j -= gap) {
         if (data[j - gap] <= temp) break;
         data[j] = data[j - gap];
@@ -264,8 +327,8 @@ void shellSortTokuda(T data[], const uint16_t n)
   }
 }
 #else
-template <typename T>
-void shellSortTokuda(T data[], uint16_t n) {
+template <typename T, typename S = uint16_t>
+void shellSortTokuda(T data[], S n) {
   // This lambda expression does not perform any captures, so the compiler will
   // optimize and inline the less-than expression.
   auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
@@ -280,32 +343,35 @@ void shellSortTokuda(T data[], uint16_t n) {
  *
  * @tparam T type of data to sort
  * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
  */
-template<typename T, typename F>
-void shellSortTokuda(T data[], const uint16_t n, F&& lessThan)
-{
-  // Experimentally observed ideal gaps.
-  // https://en.wikipedia.org/wiki/Shellsort
-  // https://oeis.org/A108870
-  static const uint16_t sGaps[] = {
-      1, 4, 9, 20, 46, 103, 233, 525, 1182, 2660, 5985, 13467, 30301,
-  };
-  const uint16_t nGaps = sizeof(sGaps) / sizeof(uint16_t);
-
-  // Find the starting gap.
+template <typename T, typename F, typename S = uint16_t>
+void shellSortTokuda(T data[], S n, F&& lessThan) {
+  // Select the gap table which is wide enough for the index type S.
+  typedef internal::TokudaGaps<(sizeof(S) > 2)> Gaps;
+  typedef typename Gaps::GapType GapType;
+  const GapType* const sGaps = Gaps::gaps();
+  const uint16_t nGaps = Gaps::kNumGaps;
+
+  // Find the starting gap. Compare using the wider of GapType and S so that
+  // neither side is truncated, even if S is a signed type.
+  typedef typename internal::Conditional<
+      (sizeof(S) > sizeof(GapType)), S, GapType>::type CompareType;
   uint16_t iGap;
-  for (iGap = 0; sGaps[iGap] < n && iGap < nGaps; iGap++) {}
+  for (iGap = 0;
+      iGap < nGaps && (CompareType) sGaps[iGap] < (CompareType) n;
+      iGap++) {}
   if (iGap != 0) iGap--;
 
   while (true) {
-    uint16_t gap = sGaps[iGap];
+    S gap = sGaps[iGap];
 
     // Do insertion sort of each sub-array separated by gap.
-    for (uint16_t i = gap; i < n; i++) {
+    for (S i = gap; i < n; i++) {
       T temp = data[i];
 
       // Shift one slot to the right.
-      uint16_t j;
+      S j;
       for (j = i; j >= gap; j -= gap) {
         // The following is equivalent to: (data[j - gap] <= temp)
         if (! lessThan(temp, data[j - gap])) break;
@@ -0,0 +1,184 @@
+/*
+MIT License
+
+Copyright (c) 2021 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file sortFixed.h
+ *
+ * Sorting networks for a number of elements known at compile time, expanded
+ * into a straight sequence of compare-exchange operations using the
+ * Bose-Nelson algorithm.
+ * See https://en.wikipedia.org/wiki/Sorting_network
+ */
+
+#ifndef ACE_SORTING_SORT_FIXED_H
+#define ACE_SORTING_SORT_FIXED_H
+
+#include <stdint.h> // uint8_t
+#include "sortingNetwork.h"
+
+namespace ace_sorting {
+
+namespace internal {
+
+/**
+ * Bose-Nelson merge of the sorted X elements starting at data[I] with the
+ * sorted Y elements starting at data[J]. The KIND selects the base cases (1
+ * to 3) or the recursive case (4), since C++11 does not allow partial
+ * specializations on expressions of the template parameters.
+ */
+template <uint8_t I, uint8_t X, uint8_t J, uint8_t Y,
+    uint8_t KIND = (X == 0 || Y == 0) ? 0
+        : (X == 1 && Y == 1) ? 1
+        : (X == 1 && Y == 2) ? 2
+        : (X == 2 && Y == 1) ? 3
+        : 4>
+struct BoseNelsonMerge {
+  template <typename T, typename F>
+  static void run(T /*data*/[], F&& /*lessThan*/) {}
+};
+
+template <uint8_t I, uint8_t X, uint8_t J, uint8_t Y>
+struct BoseNelsonMerge<I, X, J, Y, 1> {
+  template <typename T, typename F>
+  static void run(T data[], F&& lessThan) {
+    compareExchange(data, I, J, lessThan);
+  }
+};
+
+template <uint8_t I, uint8_t X, uint8_t J, uint8_t Y>
+struct BoseNelsonMerge<I, X, J, Y, 2> {
+  template <typename T, typename F>
+  static void run(T data[], F&& lessThan) {
+    compareExchange(data, I, J + 1, lessThan);
+    compareExchange(data, I, J, lessThan);
+  }
+};
+
+template <uint8_t I, uint8_t X, uint8_t J, uint8_t Y>
+struct BoseNelsonMerge<I, X, J, Y, 3> {
+  template <typename T, typename F>
+  static void run(T data[], F&& lessThan) {
+    compareExchange(data, I, J, lessThan);
+    compareExchange(data, I + 1, J, lessThan);
+  }
+};
+
+template <uint8_t I, uint8_t X, uint8_t J, uint8_t Y>
+struct BoseNelsonMerge<I, X, J, Y, 4> {
+  static const uint8_t A = X / 2;
+  static const uint8_t B = (X & 1) ? (Y / 2) : ((Y + 1) / 2);
+
+  template <typename T, typename F>
+  static void run(T data[], F&& lessThan) {
+    BoseNelsonMerge<I, A, J, B>::run(data, lessThan);
+    BoseNelsonMerge<I + A, X - A, J + B, Y - B>::run(data, lessThan);
+    BoseNelsonMerge<I + A, X - A, J, B>::run(data, lessThan);
+  }
+};
+
+/**
+ * Bose-Nelson sort of the M elements starting at data[I], by sorting each
+ * half recursively, then merging them.
+ */
+template <uint8_t I, uint8_t M, bool SPLIT = (M > 1)>
+struct BoseNelsonSort {
+  template <typename T, typename F>
+  static void run(T /*data*/[], F&& /*lessThan*/) {}
+};
+
+template <uint8_t I, uint8_t M>
+struct BoseNelsonSort<I, M, true> {
+  static const uint8_t A = M / 2;
+
+  template <typename T, typename F>
+  static void run(T data[], F&& lessThan) {
+    BoseNelsonSort<I, A>::run(data, lessThan);
+    BoseNelsonSort<I + A, M - A>::run(data, lessThan);
+    BoseNelsonMerge<I, A, I + A, M - A>::run(data, lessThan);
+  }
+};
+
+/**
+ * Select the SIMD network of sortingNetwork.h if it supports N elements of
+ * type T, otherwise the Bose-Nelson network.
+ */
+template <uint8_t N, typename T,
+    bool SIMD = SimdTraits<T>::kEnabled && (N == 8 || N == 16 || N == 32)>
+struct SortFixed {
+  static void sort(T data[]) {
+    auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
+    BoseNelsonSort<0, N>::run(data, lessThan);
+  }
+};
+
+template <uint8_t N, typename T>
+struct SortFixed<N, T, true> {
+  static void sort(T data[]) {
+    SortingNetwork<N, T>::sort(data);
+  }
+};
+
+}
+
+/**
+ * Sort exactly N elements using a sorting network generated at compile time
+ * by the Bose-Nelson algorithm. The network is expanded into a sequence of
+ * compare-exchange operations on fixed indexes, without loops or
+ * data-dependent branches for integer types, so the runtime does not depend
+ * on the data. The networks for N <= 8 use the optimal number of comparators
+ * (3, 5, 9, 12, 16, 19 for N = 3 to 8). If ACE_SORTING_SIMD is enabled and N
+ * is 8, 16 or 32, uses the SIMD network of sortingNetwork8(),
+ * sortingNetwork16() or sortingNetwork32().
+ *
+ * The flash consumption grows with the number of comparators, roughly
+ * O(N log(N)^2), so this is intended for small N like sensor windows of 3, 5
+ * or 8 samples.
+ *
+ * Stable sort: No
+ *
+ * @tparam N number of elements, up to 32
+ * @tparam T type of data to sort
+ */
+template <uint8_t N, typename T>
+void sortFixed(T data[]) {
+  static_assert(N <= 32, "sortFixed() supports at most 32 elements");
+  internal::SortFixed<N, T>::sort(data);
+}
+
+/**
+ * Same as the 1-argument sortFixed() with the addition of a `lessThan` lambda
+ * expression or function. Always uses the Bose-Nelson network.
+ *
+ * @tparam N number of elements, up to 32
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns true if a < b
+ */
+template <uint8_t N, typename T, typename F>
+void sortFixed(T data[], F&& lessThan) {
+  static_assert(N <= 32, "sortFixed() supports at most 32 elements");
+  internal::BoseNelsonSort<0, N>::run(data, lessThan);
+}
+
+}
+
+#endif
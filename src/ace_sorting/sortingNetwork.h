@@ -0,0 +1,489 @@
+/*
+MIT License
+
+Copyright (c) 2021 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file sortingNetwork.h
+ *
+ * Sorting networks for 8, 16 and 32 elements. On processors with SSE4.1 (e.g.
+ * when running natively on x86-64 through EpoxyDuino), integer and floating
+ * point elements are sorted with a bitonic network using SIMD min/max
+ * instructions. Otherwise, the network is Batcher's odd-even merge sort using
+ * scalar compare-exchange operations.
+ * See https://en.wikipedia.org/wiki/Sorting_network
+ */
+
+#ifndef ACE_SORTING_SORTING_NETWORK_H
+#define ACE_SORTING_SORTING_NETWORK_H
+
+#include <stdint.h> // uint8_t, uint16_t, uint32_t
+#include "insertionSort.h"
+
+#if ! defined(ACE_SORTING_SIMD)
+  #if defined(__SSE4_1__)
+    /**
+     * If set to 1, the 1-argument sortingNetworkXxx() functions use SSE4.1
+     * instructions for `int16_t`, `uint16_t`, `int32_t`, `uint32_t` and
+     * `float` elements. Enabled automatically when the compiler targets
+     * SSE4.1 (e.g. `-msse4.1` or `-march=native` on x86-64). Set to 0 to force
+     * the scalar implementation.
+     */
+    #define ACE_SORTING_SIMD 1
+  #else
+    #define ACE_SORTING_SIMD 0
+  #endif
+#endif
+
+#if ACE_SORTING_SIMD
+  #include <smmintrin.h> // SSE4.1 intrinsics
+#endif
+
+namespace ace_sorting {
+
+namespace internal {
+
+/**
+ * Exchange data[i] and data[j] (where i < j) if they are out of order. The
+ * elements are selected without a branch, so that the compiler can use
+ * conditional moves or min/max instructions for arithmetic types.
+ */
+template <typename T, typename F>
+inline void compareExchange(T data[], uint8_t i, uint8_t j, F&& lessThan) {
+  T a = data[i];
+  T b = data[j];
+  // Written as 2 independent selects so that the compiler can recognize
+  // min() and max() of floating point numbers.
+  data[i] = lessThan(b, a) ? b : a;
+  data[j] = lessThan(b, a) ? a : b;
+}
+
+/**
+ * Batcher's merge exchange network of N elements (Knuth, TAOCP Vol 3,
+ * Algorithm 5.2.2M), where N is a power of 2. Uses 19, 63 and 191 comparators
+ * for N = 8, 16 and 32.
+ * See https://en.wikipedia.org/wiki/Batcher_odd%E2%80%93even_mergesort
+ */
+template <uint8_t N, typename T, typename F>
+void batcherNetwork(T data[], F&& lessThan) {
+  for (uint8_t p = N / 2; p > 0; p /= 2) {
+    uint8_t q = N / 2;
+    uint8_t r = 0;
+    uint8_t d = p;
+    while (true) {
+      for (uint8_t i = 0; i < N - d; i++) {
+        if ((i & p) == r) compareExchange(data, i, i + d, lessThan);
+      }
+      if (q == p) break;
+      d = q - p;
+      q /= 2;
+      r = p;
+    }
+  }
+}
+
+/**
+ * SIMD operations on elements of type T. Specialized for the types which are
+ * supported by SSE4.1 when ACE_SORTING_SIMD is enabled.
+ */
+template <typename T>
+struct SimdTraits {
+  /** True if the bitonic SIMD network can sort type T. */
+  static const bool kEnabled = false;
+
+  /**
+   * True if a partial array can be padded with kMax and sorted with the
+   * network. Not used for floating point types because NaN has no place in
+   * the ordering.
+   */
+  static const bool kPaddable = false;
+};
+
+#if ACE_SORTING_SIMD
+
+/** Number of elements of type T in a 128-bit register. */
+template <typename T>
+struct SimdLanes {
+  static const uint8_t kLanes = 16 / sizeof(T);
+};
+
+template <>
+struct SimdTraits<uint16_t> : SimdLanes<uint16_t> {
+  static const bool kEnabled = true;
+  static const bool kPaddable = true;
+  static const uint16_t kMax = 0xFFFF;
+  static __m128i min(__m128i a, __m128i b) { return _mm_min_epu16(a, b); }
+  static __m128i max(__m128i a, __m128i b) { return _mm_max_epu16(a, b); }
+};
+
+template <>
+struct SimdTraits<int16_t> : SimdLanes<int16_t> {
+  static const bool kEnabled = true;
+  static const bool kPaddable = true;
+  static const int16_t kMax = 0x7FFF;
+  static __m128i min(__m128i a, __m128i b) { return _mm_min_epi16(a, b); }
+  static __m128i max(__m128i a, __m128i b) { return _mm_max_epi16(a, b); }
+};
+
+template <>
+struct SimdTraits<uint32_t> : SimdLanes<uint32_t> {
+  static const bool kEnabled = true;
+  static const bool kPaddable = true;
+  static const uint32_t kMax = 0xFFFFFFFF;
+  static __m128i min(__m128i a, __m128i b) { return _mm_min_epu32(a, b); }
+  static __m128i max(__m128i a, __m128i b) { return _mm_max_epu32(a, b); }
+};
+
+template <>
+struct SimdTraits<int32_t> : SimdLanes<int32_t> {
+  static const bool kEnabled = true;
+  static const bool kPaddable = true;
+  static const int32_t kMax = 0x7FFFFFFF;
+  static __m128i min(__m128i a, __m128i b) { return _mm_min_epi32(a, b); }
+  static __m128i max(__m128i a, __m128i b) { return _mm_max_epi32(a, b); }
+};
+
+/**
+ * The MINPS and MAXPS instructions return their 2nd operand if the operands
+ * compare equal (e.g. -0.0 and +0.0) or either one is a NaN. Callers must
+ * ensure that each input ends up in exactly one of the outputs in that case,
+ * so that no value is lost or duplicated: either by passing the operands as
+ * min(a, b) and max(b, a), or by using lane-symmetric operands like
+ * simdExchangeLanes().
+ */
+template <>
+struct SimdTraits<float> : SimdLanes<float> {
+  static const bool kEnabled = true;
+  static const bool kPaddable = false;
+  static __m128i min(__m128i a, __m128i b) {
+    return _mm_castps_si128(_mm_min_ps(_mm_castsi128_ps(a),
+        _mm_castsi128_ps(b)));
+  }
+  static __m128i max(__m128i a, __m128i b) {
+    return _mm_castps_si128(_mm_max_ps(_mm_castsi128_ps(a),
+        _mm_castsi128_ps(b)));
+  }
+};
+
+/**
+ * Index of the source byte of byte `b` of a PSHUFB permutation which moves the
+ * element in lane `i` to lane `i ^ m`, where each lane has `size` bytes.
+ */
+constexpr char simdPermuteByte(uint8_t m, uint8_t size, uint8_t b) {
+  return (char) (((b / size) ^ m) * size + b % size);
+}
+
+/**
+ * Immediate operand of PBLENDW which selects the 2nd operand for the 16-bit
+ * words in the lanes whose index has the bit `bit` set.
+ */
+constexpr int simdBlendMask(uint8_t bit, uint8_t size, uint8_t w = 0) {
+  return (w == 8)
+      ? 0
+      : ((((w * 2 / size) & bit) ? 1 : 0) << w)
+          | simdBlendMask(bit, size, w + 1);
+}
+
+/** Move the element in lane `i` to lane `i ^ M`. */
+template <typename T, uint8_t M>
+inline __m128i simdPermute(__m128i v) {
+  const uint8_t s = sizeof(T);
+  const __m128i perm = _mm_setr_epi8(
+      simdPermuteByte(M, s, 0), simdPermuteByte(M, s, 1),
+      simdPermuteByte(M, s, 2), simdPermuteByte(M, s, 3),
+      simdPermuteByte(M, s, 4), simdPermuteByte(M, s, 5),
+      simdPermuteByte(M, s, 6), simdPermuteByte(M, s, 7),
+      simdPermuteByte(M, s, 8), simdPermuteByte(M, s, 9),
+      simdPermuteByte(M, s, 10), simdPermuteByte(M, s, 11),
+      simdPermuteByte(M, s, 12), simdPermuteByte(M, s, 13),
+      simdPermuteByte(M, s, 14), simdPermuteByte(M, s, 15));
+  return _mm_shuffle_epi8(v, perm);
+}
+
+/** Reverse the order of the lanes of a register. */
+template <typename T>
+inline __m128i simdReverse(__m128i v) {
+  return simdPermute<T, SimdLanes<T>::kLanes - 1>(v);
+}
+
+/**
+ * Compare-exchange the lanes `i` and `i ^ M` of a single register. The lane
+ * whose index has the bit `B` cleared receives the minimum.
+ */
+template <typename T, uint8_t M, uint8_t B>
+inline __m128i simdExchangeLanes(__m128i v) {
+  typedef SimdTraits<T> Traits;
+  // An enum forces the blend mask to be an immediate operand even at -O0.
+  enum { kBlendMask = simdBlendMask(B, sizeof(T)) };
+  __m128i p = simdPermute<T, M>(v);
+  // Both calls use the operand order (v, p), but p holds the partner of each
+  // lane, so lane i computes min(v[i], v[j]) and lane j computes
+  // max(v[j], v[i]). For equal or NaN operands, lane i receives v[j] and lane
+  // j receives v[i], so the 2 elements are swapped instead of duplicated.
+  __m128i lo = Traits::min(v, p);
+  __m128i hi = Traits::max(v, p);
+  return _mm_blend_epi16(lo, hi, kBlendMask);
+}
+
+/**
+ * Half-cleaner stages of the bitonic merge of a network of R registers,
+ * comparing the elements at distance J, J/2, ..., 1.
+ */
+template <typename T, uint8_t R, uint8_t J>
+struct SimdBitonicClean {
+  static void run(__m128i v[]) {
+    typedef SimdTraits<T> Traits;
+    const uint8_t kLanes = Traits::kLanes;
+    if (J >= kLanes) {
+      const uint8_t g = J / kLanes;
+      for (uint8_t r = 0; r < R; r++) {
+        if (r & g) continue;
+        __m128i a = v[r];
+        __m128i b = v[r | g];
+        v[r] = Traits::min(a, b);
+        v[r | g] = Traits::max(b, a);
+      }
+    } else {
+      for (uint8_t r = 0; r < R; r++) {
+        v[r] = simdExchangeLanes<T, J % kLanes, J % kLanes>(v[r]);
+      }
+    }
+    SimdBitonicClean<T, R, J / 2>::run(v);
+  }
+};
+
+template <typename T, uint8_t R>
+struct SimdBitonicClean<T, R, 0> {
+  static void run(__m128i /*v*/[]) {}
+};
+
+/**
+ * Bitonic sort of blocks of K elements in a network of R registers. Each
+ * merge starts by comparing element `i` with its mirror image in the block,
+ * so that every block is sorted in ascending order and no lane needs to be
+ * sorted in descending order.
+ */
+template <typename T, uint8_t R, uint8_t K>
+struct SimdBitonicSort {
+  static void run(__m128i v[]) {
+    typedef SimdTraits<T> Traits;
+    const uint8_t kLanes = Traits::kLanes;
+    SimdBitonicSort<T, R, K / 2>::run(v);
+
+    if (K <= kLanes) {
+      for (uint8_t r = 0; r < R; r++) {
+        v[r] = simdExchangeLanes<T, (K - 1) % kLanes, (K / 2) % kLanes>(v[r]);
+      }
+    } else {
+      const uint8_t g = K / kLanes;
+      for (uint8_t r = 0; r < R; r++) {
+        if (r % g >= g / 2) continue;
+        uint8_t r2 = r ^ (g - 1);
+        __m128i a = v[r];
+        __m128i b = simdReverse<T>(v[r2]);
+        v[r] = Traits::min(a, b);
+        v[r2] = simdReverse<T>(Traits::max(b, a));
+      }
+    }
+
+    SimdBitonicClean<T, R, K / 4>::run(v);
+  }
+};
+
+template <typename T, uint8_t R>
+struct SimdBitonicSort<T, R, 1> {
+  static void run(__m128i /*v*/[]) {}
+};
+
+/** Sort N elements of data[] using the SIMD bitonic network. */
+template <uint8_t N, typename T>
+void simdBitonicNetwork(T data[]) {
+  const uint8_t kLanes = SimdTraits<T>::kLanes;
+  const uint8_t kRegisters = N / kLanes;
+  __m128i v[kRegisters];
+  for (uint8_t r = 0; r < kRegisters; r++) {
+    v[r] = _mm_loadu_si128((const __m128i*) (data + r * kLanes));
+  }
+  SimdBitonicSort<T, kRegisters, N>::run(v);
+  for (uint8_t r = 0; r < kRegisters; r++) {
+    _mm_storeu_si128((__m128i*) (data + r * kLanes), v[r]);
+  }
+}
+
+#endif
+
+/**
+ * Select the SIMD network or the scalar network for N elements of type T,
+ * sorted in ascending order.
+ */
+template <uint8_t N, typename T, bool SIMD = SimdTraits<T>::kEnabled>
+struct SortingNetwork {
+  static void sort(T data[]) {
+    auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
+    batcherNetwork<N>(data, lessThan);
+  }
+};
+
+#if ACE_SORTING_SIMD
+template <uint8_t N, typename T>
+struct SortingNetwork<N, T, true> {
+  static void sort(T data[]) {
+    simdBitonicNetwork<N>(data);
+  }
+};
+#endif
+
+/**
+ * Sort the small partitions of the 2-argument quickSortXxx() functions. By
+ * default, uses insertionSort().
+ */
+template <typename T, bool PADDED = SimdTraits<T>::kPaddable>
+struct SmallSort {
+  template <typename S>
+  static void sort(T data[], S n) {
+    insertionSort(data, n);
+  }
+};
+
+#if ACE_SORTING_SIMD
+/**
+ * If the SIMD network supports type T, copy the `n <= 32` elements into a
+ * buffer of 8, 16 or 32 elements padded with the largest value of T, sort the
+ * buffer with the network, and copy the first `n` elements back.
+ */
+template <typename T>
+struct SmallSort<T, true> {
+  template <typename S>
+  static void sort(T data[], S n) {
+    if (n <= 1) return;
+    if (n > 32) {
+      insertionSort(data, n);
+      return;
+    }
+
+    T buffer[32];
+    uint8_t size = (n <= 8) ? 8 : (n <= 16) ? 16 : 32;
+    for (uint8_t i = 0; i < n; i++) {
+      buffer[i] = data[i];
+    }
+    for (uint8_t i = n; i < size; i++) {
+      buffer[i] = SimdTraits<T>::kMax;
+    }
+    if (size == 8) {
+      simdBitonicNetwork<8>(buffer);
+    } else if (size == 16) {
+      simdBitonicNetwork<16>(buffer);
+    } else {
+      simdBitonicNetwork<32>(buffer);
+    }
+    for (uint8_t i = 0; i < n; i++) {
+      data[i] = buffer[i];
+    }
+  }
+};
+#endif
+
+}
+
+/**
+ * Sort exactly 8 elements using a sorting network. Uses SSE4.1 instructions
+ * for `int16_t`, `uint16_t`, `int32_t`, `uint32_t` and `float` if
+ * ACE_SORTING_SIMD is enabled.
+ *
+ * Complexity: O(1), 19 comparators (scalar) or 6 SIMD stages.
+ * Stable sort: No
+ *
+ * @tparam T type of data to sort
+ */
+template <typename T>
+void sortingNetwork8(T data[]) {
+  internal::SortingNetwork<8, T>::sort(data);
+}
+
+/**
+ * Same as the 1-argument sortingNetwork8() with the addition of a `lessThan`
+ * lambda expression or function. Always uses the scalar network.
+ *
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns true if a < b
+ */
+template <typename T, typename F>
+void sortingNetwork8(T data[], F&& lessThan) {
+  internal::batcherNetwork<8>(data, lessThan);
+}
+
+/**
+ * Sort exactly 16 elements using a sorting network. Uses SSE4.1 instructions
+ * for `int16_t`, `uint16_t`, `int32_t`, `uint32_t` and `float` if
+ * ACE_SORTING_SIMD is enabled.
+ *
+ * Complexity: O(1), 63 comparators (scalar) or 10 SIMD stages.
+ * Stable sort: No
+ *
+ * @tparam T type of data to sort
+ */
+template <typename T>
+void sortingNetwork16(T data[]) {
+  internal::SortingNetwork<16, T>::sort(data);
+}
+
+/**
+ * Same as the 1-argument sortingNetwork16() with the addition of a `lessThan`
+ * lambda expression or function. Always uses the scalar network.
+ *
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns true if a < b
+ */
+template <typename T, typename F>
+void sortingNetwork16(T data[], F&& lessThan) {
+  internal::batcherNetwork<16>(data, lessThan);
+}
+
+/**
+ * Sort exactly 32 elements using a sorting network. Uses SSE4.1 instructions
+ * for `int16_t`, `uint16_t`, `int32_t`, `uint32_t` and `float` if
+ * ACE_SORTING_SIMD is enabled.
+ *
+ * Complexity: O(1), 191 comparators (scalar) or 15 SIMD stages.
+ * Stable sort: No
+ *
+ * @tparam T type of data to sort
+ */
+template <typename T>
+void sortingNetwork32(T data[]) {
+  internal::SortingNetwork<32, T>::sort(data);
+}
+
+/**
+ * Same as the 1-argument sortingNetwork32() with the addition of a `lessThan`
+ * lambda expression or function. Always uses the scalar network.
+ *
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns true if a < b
+ */
+template <typename T, typename F>
+void sortingNetwork32(T data[], F&& lessThan) {
+  internal::batcherNetwork<32>(data, lessThan);
+}
+
+}
+
+#endif
@@ -0,0 +1,459 @@
+/*
+MIT License
+
+Copyright (c) 2021 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/**
+ * @file timSort.h
+ *
+ * TimSort, a stable natural merge sort which takes advantage of the runs of
+ * elements already in order.
+ * See https://en.wikipedia.org/wiki/Timsort and
+ * https://github.com/python/cpython/blob/main/Objects/listsort.txt
+ */
+
+#ifndef ACE_SORTING_TIM_SORT_H
+#define ACE_SORTING_TIM_SORT_H
+
+#include <stdint.h> // uint8_t, uint16_t
+#include "mergeSortInPlace.h" // reverseRange()
+
+namespace ace_sorting {
+
+namespace internal {
+
+/**
+ * Arrays smaller than this are sorted using a binary insertion sort. Runs
+ * shorter than timSortMinRun(n), which is between kTimSortMinMerge/2 and
+ * kTimSortMinMerge, are extended to that length using the binary insertion
+ * sort.
+ */
+const uint8_t kTimSortMinMerge = 32;
+
+/**
+ * Initial number of consecutive wins of one run required to switch to
+ * galloping mode.
+ */
+const uint8_t kTimSortMinGallop = 7;
+
+/**
+ * Return the minimum length of a run, chosen so that n / minRun is equal to,
+ * or slightly smaller than, a power of 2, which keeps the merges balanced.
+ */
+template <typename S>
+S timSortMinRun(S n) {
+  S r = 0;
+  while (n >= kTimSortMinMerge) {
+    r |= (n & 1);
+    n >>= 1;
+  }
+  return n + r;
+}
+
+/**
+ * Return the length of the run at the beginning of data[]. A strictly
+ * descending run is reversed in place. The run must be strictly descending,
+ * not just non-increasing, to keep the sort stable.
+ */
+template <typename T, typename F, typename S>
+S timSortCountRun(T data[], S n, F&& lessThan) {
+  if (n < 2) return n;
+
+  S i = 2;
+  if (lessThan(data[1], data[0])) {
+    while (i < n && lessThan(data[i], data[i - 1])) i++;
+    reverseRange(data, data + i);
+  } else {
+    while (i < n && ! lessThan(data[i], data[i - 1])) i++;
+  }
+  return i;
+}
+
+/**
+ * Insertion sort of data[0, n) where data[0, start) is already sorted, using
+ * a binary search to find the insertion point of each element. The element is
+ * inserted after any equal elements to keep the sort stable. The binary
+ * search always halves the remaining range without branching on the
+ * comparison, which the compiler can implement with a conditional move,
+ * avoiding a branch misprediction on every other comparison.
+ */
+template <typename T, typename F, typename S>
+void timSortBinaryInsertion(T data[], S n, S start, F&& lessThan) {
+  if (start == 0) start = 1;
+  for (S i = start; i < n; i++) {
+    T temp = data[i];
+    T* base = data;
+    S len = i;
+    while (len > 1) {
+      S half = len / 2;
+      base = lessThan(temp, base[half]) ? base : base + half;
+      len -= half;
+    }
+    S pos = (base - data) + ! lessThan(temp, *base);
+    for (S j = i; j > pos; j--) {
+      data[j] = data[j - 1];
+    }
+    data[pos] = temp;
+  }
+}
+
+/**
+ * Return the number of elements of the sorted base[0, n) which come before
+ * `key`. If RIGHT is false, these are the elements less than `key`. If RIGHT
+ * is true, these are the elements less than or equal to `key`, so that
+ * `key` is placed after the elements equal to it.
+ *
+ * The search starts at base[hint], and probes positions at exponentially
+ * increasing distances from it (1, 3, 7, 15, ...) before finishing with a
+ * binary search. This finds the answer in O(log(d)) comparisons, where `d`
+ * is the distance between `hint` and the answer.
+ */
+template <bool RIGHT, typename T, typename F, typename S>
+S timSortGallop(const T& key, const T base[], S n, S hint, F&& lessThan) {
+  auto&& isBefore = [&key, &lessThan](const T& x) -> bool {
+    return RIGHT ? ! lessThan(key, x) : lessThan(x, key);
+  };
+
+  // Find the range [lo, hi] which contains the answer.
+  S lo;
+  S hi;
+  S lastOffset = 0;
+  S offset = 1;
+  if (isBefore(base[hint])) {
+    S maxOffset = n - hint;
+    while (offset < maxOffset && isBefore(base[hint + offset])) {
+      lastOffset = offset;
+      offset = (offset > (maxOffset - 1) / 2) ? maxOffset : 2 * offset + 1;
+    }
+    lo = hint + lastOffset + 1;
+    hi = hint + offset;
+  } else {
+    S maxOffset = hint + 1;
+    while (offset < maxOffset && ! isBefore(base[hint - offset])) {
+      lastOffset = offset;
+      offset = (offset > (maxOffset - 1) / 2) ? maxOffset : 2 * offset + 1;
+    }
+    lo = hint + 1 - offset;
+    hi = hint - lastOffset;
+  }
+
+  while (lo < hi) {
+    S mid = lo + (hi - lo) / 2;
+    if (isBefore(base[mid])) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return hi;
+}
+
+/**
+ * The state of timSort(): the stack of pending runs which have not been
+ * merged yet, and the galloping threshold which adapts to the data.
+ *
+ * The lengths of the runs on the stack satisfy `len[i-2] > len[i-1] +
+ * len[i]` and `len[i-1] > len[i]`, so they grow at least as fast as the
+ * Fibonacci numbers, and the stack never holds more than about
+ * `1.44 * log2(n)` runs. The stack is sized for the largest `n` of the index
+ * type S.
+ */
+template <typename T, typename F, typename S>
+class TimSort {
+  public:
+    TimSort(T data[], T buffer[], F& lessThan) :
+        mData(data),
+        mBuffer(buffer),
+        mLessThan(lessThan),
+        mMinGallop(kTimSortMinGallop),
+        mNumRuns(0)
+    {}
+
+    /** Push the run data[base, base + n) onto the stack. */
+    void pushRun(S base, S n) {
+      mRunBase[mNumRuns] = base;
+      mRunLength[mNumRuns] = n;
+      mNumRuns++;
+    }
+
+    /**
+     * Merge the runs at the top of the stack until the invariants on their
+     * lengths are restored. Includes the check on the 4th run from the top,
+     * which was missing from the original TimSort (see "OpenJDK's
+     * java.utils.Collection.sort() is broken" by de Gouw et al, 2015).
+     */
+    void mergeCollapse() {
+      while (mNumRuns > 1) {
+        uint8_t i = mNumRuns - 2;
+        S* len = mRunLength;
+        if ((i > 0 && len[i - 1] <= len[i] + len[i + 1])
+            || (i > 1 && len[i - 2] <= len[i - 1] + len[i])) {
+          if (len[i - 1] < len[i + 1]) i--;
+        } else if (len[i] > len[i + 1]) {
+          break;
+        }
+        mergeAt(i);
+      }
+    }
+
+    /** Merge all the runs on the stack, at the end of the sort. */
+    void mergeForceCollapse() {
+      while (mNumRuns > 1) {
+        uint8_t i = mNumRuns - 2;
+        if (i > 0 && mRunLength[i - 1] < mRunLength[i + 1]) i--;
+        mergeAt(i);
+      }
+    }
+
+  private:
+    static const uint8_t kStackSize = sizeof(S) * 8 * 3 / 2 + 1;
+
+    /** Merge the runs at stack index i and i + 1. */
+    void mergeAt(uint8_t i) {
+      S base1 = mRunBase[i];
+      S len1 = mRunLength[i];
+      S base2 = mRunBase[i + 1];
+      S len2 = mRunLength[i + 1];
+
+      // Record the merged run, and remove the run at i + 1.
+      mRunLength[i] = len1 + len2;
+      if (i + 3 == mNumRuns) {
+        mRunBase[i + 1] = mRunBase[i + 2];
+        mRunLength[i + 1] = mRunLength[i + 2];
+      }
+      mNumRuns--;
+
+      // The elements of run1 which are not greater than the first element of
+      // run2, and the elements of run2 which are not less than the last
+      // element of run1, are already in place.
+      S k = timSortGallop<true>(mData[base2], mData + base1, len1, (S) 0,
+          mLessThan);
+      base1 += k;
+      len1 -= k;
+      if (len1 == 0) return;
+      len2 = timSortGallop<false>(mData[base1 + len1 - 1], mData + base2,
+          len2, (S) (len2 - 1), mLessThan);
+      if (len2 == 0) return;
+
+      // Copy the shorter run into the buffer, which needs at most n/2
+      // elements.
+      if (len1 <= len2) {
+        mergeLow(mData + base1, len1, mData + base2, len2);
+      } else {
+        mergeHigh(mData + base1, len1, mData + base2, len2);
+      }
+    }
+
+    /** Merge from the left, when run1 is shorter than run2. */
+    void mergeLow(T* run1, S len1, T* run2, S len2) {
+      for (S i = 0; i < len1; i++) {
+        mBuffer[i] = run1[i];
+      }
+      T* a = mBuffer;
+      T* aEnd = mBuffer + len1;
+      T* b = run2;
+      T* bEnd = run2 + len2;
+      T* out = run1;
+
+      bool done = false;
+      while (! done) {
+        // Take one element at a time, until one run wins kMinGallop times in
+        // a row. Equal elements are taken from run1 first for stability.
+        S count1 = 0;
+        S count2 = 0;
+        while (true) {
+          if (mLessThan(*b, *a)) {
+            *out++ = *b++;
+            count1 = 0;
+            count2++;
+            if (b == bEnd) { done = true; break; }
+          } else {
+            *out++ = *a++;
+            count1++;
+            count2 = 0;
+            if (a == aEnd) { done = true; break; }
+          }
+          if (count1 >= mMinGallop || count2 >= mMinGallop) break;
+        }
+        if (done) break;
+
+        // Galloping mode. Copy whole blocks of elements from each run, until
+        // the blocks become too small to be worth it.
+        while (true) {
+          count1 = timSortGallop<true>(*b, a, (S) (aEnd - a), (S) 0,
+              mLessThan);
+          for (S i = 0; i < count1; i++) *out++ = *a++;
+          if (a == aEnd) { done = true; break; }
+          *out++ = *b++;
+          if (b == bEnd) { done = true; break; }
+
+          count2 = timSortGallop<false>(*a, b, (S) (bEnd - b), (S) 0,
+              mLessThan);
+          for (S i = 0; i < count2; i++) *out++ = *b++;
+          if (b == bEnd) { done = true; break; }
+          *out++ = *a++;
+          if (a == aEnd) { done = true; break; }
+
+          if (mMinGallop > 0) mMinGallop--;
+          if (count1 < kTimSortMinGallop && count2 < kTimSortMinGallop) break;
+        }
+        // Galloping did not pay off. Make it harder to enter again.
+        mMinGallop += 2;
+      }
+
+      // The remaining elements of run2 are already in place.
+      while (a < aEnd) *out++ = *a++;
+    }
+
+    /** Merge from the right, when run2 is shorter than run1. */
+    void mergeHigh(T* run1, S len1, T* run2, S len2) {
+      for (S i = 0; i < len2; i++) {
+        mBuffer[i] = run2[i];
+      }
+      T* a = run1 + len1;
+      T* aBegin = run1;
+      T* b = mBuffer + len2;
+      T* bBegin = mBuffer;
+      T* out = run2 + len2;
+
+      bool done = false;
+      while (! done) {
+        S count1 = 0;
+        S count2 = 0;
+        while (true) {
+          if (mLessThan(b[-1], a[-1])) {
+            *--out = *--a;
+            count1++;
+            count2 = 0;
+            if (a == aBegin) { done = true; break; }
+          } else {
+            *--out = *--b;
+            count1 = 0;
+            count2++;
+            if (b == bBegin) { done = true; break; }
+          }
+          if (count1 >= mMinGallop || count2 >= mMinGallop) break;
+        }
+        if (done) break;
+
+        while (true) {
+          S n1 = a - aBegin;
+          count1 = n1 - timSortGallop<true>(b[-1], aBegin, n1, (S) (n1 - 1),
+              mLessThan);
+          for (S i = 0; i < count1; i++) *--out = *--a;
+          if (a == aBegin) { done = true; break; }
+          *--out = *--b;
+          if (b == bBegin) { done = true; break; }
+
+          S n2 = b - bBegin;
+          count2 = n2 - timSortGallop<false>(a[-1], bBegin, n2, (S) (n2 - 1),
+              mLessThan);
+          for (S i = 0; i < count2; i++) *--out = *--b;
+          if (b == bBegin) { done = true; break; }
+          *--out = *--a;
+          if (a == aBegin) { done = true; break; }
+
+          if (mMinGallop > 0) mMinGallop--;
+          if (count1 < kTimSortMinGallop && count2 < kTimSortMinGallop) break;
+        }
+        mMinGallop += 2;
+      }
+
+      // The remaining elements of run1 are already in place.
+      while (b > bBegin) *--out = *--b;
+    }
+
+    T* const mData;
+    T* const mBuffer;
+    F& mLessThan;
+    S mMinGallop;
+    uint8_t mNumRuns;
+    S mRunBase[kStackSize];
+    S mRunLength[kStackSize];
+};
+
+}
+
+/**
+ * TimSort. A stable natural merge sort, which finds the runs of elements
+ * already in ascending (or strictly descending) order, extends the short runs
+ * to a minimum length using a binary insertion sort, then merges the runs.
+ * When one run wins many comparisons in a row during a merge, the merge
+ * switches to galloping mode, which finds the end of the winning block using
+ * an exponential search and copies the whole block. The caller supplies a
+ * scratch `buffer` which must hold at least `n/2` elements, like
+ * mergeSort().
+ *
+ * Average complexity: O(n log(n))
+ * Worst complexity: O(n log(n))
+ * Best complexity: O(n) for sorted or reverse sorted data, O(n log(k)) for
+ * data made of k sorted runs
+ *
+ * @tparam T type of data to sort
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename S = uint16_t>
+void timSort(T data[], S n, T buffer[]) {
+  auto&& lessThan = [](const T& a, const T& b) -> bool { return a < b; };
+  timSort(data, n, buffer, lessThan);
+}
+
+/**
+ * Same as the 3-argument timSort() with the addition of a `lessThan` lambda
+ * expression or function.
+ *
+ * @tparam T type of data to sort
+ * @tparam F type of lambda expression or function that returns true if a < b
+ * @tparam S type of the index into data[], usually inferred from `n`
+ */
+template <typename T, typename F, typename S = uint16_t>
+void timSort(T data[], S n, T buffer[], F&& lessThan) {
+  if (n < 2) return;
+
+  if (n < internal::kTimSortMinMerge) {
+    S runLength = internal::timSortCountRun(data, n, lessThan);
+    internal::timSortBinaryInsertion(data, n, runLength, lessThan);
+    return;
+  }
+
+  internal::TimSort<T, F, S> state(data, buffer, lessThan);
+  S minRun = internal::timSortMinRun(n);
+  S base = 0;
+  S remaining = n;
+  while (remaining > 0) {
+    S runLength = internal::timSortCountRun(data + base, remaining, lessThan);
+    if (runLength < minRun) {
+      S forced = (remaining < minRun) ? remaining : minRun;
+      internal::timSortBinaryInsertion(
+          data + base, forced, runLength, lessThan);
+      runLength = forced;
+    }
+    state.pushRun(base, runLength);
+    state.mergeCollapse();
+    base += runLength;
+    remaining -= runLength;
+  }
+  state.mergeForceCollapse();
+}
+
+}
+
+#endif
@@ -0,0 +1,49 @@
+/*
+MIT License
+
+Copyright (c) 2021 Brian T. Park
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file typeIdentity.h
+ *
+ * Same as std::type_identity of C++20, which is not available on AVR.
+ */
+
+#ifndef ACE_SORTING_TYPE_IDENTITY_H
+#define ACE_SORTING_TYPE_IDENTITY_H
+
+namespace ace_sorting {
+
+namespace internal {
+
+/**
+ * Declares a function parameter of type `T` in a non-deduced context, so that
+ * `T` is deduced only from the other parameters. For example, the type of `k`
+ * is given by `n`, and a literal (e.g. `10`) can be passed as `k`.
+ */
+template <typename T> struct TypeIdentity { typedef T type; };
+
+}
+
+}
+
+#endif
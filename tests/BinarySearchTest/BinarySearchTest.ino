@@ -0,0 +1,154 @@
+#line 2 "BinarySearchTest.ino"
+
+#include <Arduino.h>
+#include <AUnit.h>
+#include <AceCommon.h>
+#include <AceSorting.h>
+
+using aunit::TestRunner;
+using aunit::TestOnce;
+using ace_sorting::lowerBound;
+using ace_sorting::upperBound;
+using ace_sorting::equalRange;
+using ace_sorting::binarySearch;
+using ace_sorting::lowerBoundBranchless;
+using ace_sorting::upperBoundBranchless;
+using ace_sorting::IndexRange;
+using ace_sorting::insertionSort;
+
+//-----------------------------------------------------------------------------
+
+class BinarySearchTest : public TestOnce {
+  public:
+    // Fill data[] with sorted random values in [0, numKeys), so that there are
+    // duplicates.
+    static void fillSorted(uint16_t data[], uint16_t n, uint16_t numKeys) {
+      for (uint16_t i = 0; i < n; i++) {
+        data[i] = random(numKeys);
+      }
+      insertionSort(data, n);
+    }
+
+    // Compare each function against a linear scan, for all values from 0 to
+    // numKeys (which is larger than every element), and for all sizes up to n.
+    void assertSearch(uint16_t n, uint16_t numKeys) {
+      uint16_t data[64];
+      fillSorted(data, n, numKeys);
+
+      for (uint16_t size = 0; size <= n; size++) {
+        for (uint16_t value = 0; value <= numKeys; value++) {
+          uint16_t lower = 0;
+          while (lower < size && data[lower] < value) lower++;
+          uint16_t upper = lower;
+          while (upper < size && data[upper] == value) upper++;
+
+          assertEqual(lowerBound(data, size, value), lower);
+          assertEqual(upperBound(data, size, value), upper);
+          assertEqual(lowerBoundBranchless(data, size, value), lower);
+          assertEqual(upperBoundBranchless(data, size, value), upper);
+
+          IndexRange<uint16_t> range = equalRange(data, size, value);
+          assertEqual(range.first, lower);
+          assertEqual(range.last, upper);
+
+          uint16_t found = binarySearch(data, size, value);
+          assertEqual(found, (lower == upper) ? size : lower);
+        }
+      }
+    }
+};
+
+testF(BinarySearchTest, empty) {
+  uint16_t data[1] = {1};
+  assertEqual(lowerBound(data, (uint16_t) 0, 1), 0);
+  assertEqual(upperBound(data, (uint16_t) 0, 1), 0);
+  assertEqual(lowerBoundBranchless(data, (uint16_t) 0, 1), 0);
+  assertEqual(upperBoundBranchless(data, (uint16_t) 0, 1), 0);
+  assertEqual(binarySearch(data, (uint16_t) 0, 1), 0);
+}
+
+testF(BinarySearchTest, fewKeys) {
+  assertNoFatalFailure(assertSearch(64, 8));
+}
+
+testF(BinarySearchTest, manyKeys) {
+  assertNoFatalFailure(assertSearch(64, 200));
+}
+
+// Search an array sorted in reverse using the same 'lessThan' as the sort.
+testF(BinarySearchTest, reverse) {
+  auto&& greaterThan = [](uint16_t a, uint16_t b) { return a > b; };
+  const uint16_t data[] = {50, 40, 40, 40, 30, 20, 10};
+  const uint16_t n = sizeof(data) / sizeof(data[0]);
+
+  assertEqual(lowerBound(data, n, 40, greaterThan), 1);
+  assertEqual(upperBound(data, n, 40, greaterThan), 4);
+  assertEqual(lowerBoundBranchless(data, n, 40, greaterThan), 1);
+  assertEqual(upperBoundBranchless(data, n, 40, greaterThan), 4);
+  assertEqual(lowerBound(data, n, 60, greaterThan), 0);
+  assertEqual(lowerBound(data, n, 5, greaterThan), n);
+
+  IndexRange<uint16_t> range = equalRange(data, n, 35, greaterThan);
+  assertEqual(range.first, 4);
+  assertEqual(range.last, 4);
+  assertEqual(binarySearch(data, n, 20, greaterThan), 5);
+  assertEqual(binarySearch(data, n, 25, greaterThan), n);
+}
+
+// Lookup of a calibration table, sorted by a compound key.
+testF(BinarySearchTest, lessThan) {
+  struct Calibration {
+    int16_t adc;
+    int16_t millivolts;
+  };
+  const Calibration table[] = {
+    {0, 0}, {100, 480}, {200, 990}, {400, 2010}, {800, 4050},
+  };
+  auto&& lessThan = [](const Calibration& a, const Calibration& b) {
+    return a.adc < b.adc;
+  };
+
+  uint8_t i = upperBound(table, (uint8_t) 5, Calibration{300, 0}, lessThan);
+  assertEqual(i, 3);
+  assertEqual(table[i - 1].millivolts, 990);
+  assertEqual(binarySearch(table, (uint8_t) 5, Calibration{400, 0}, lessThan),
+      3);
+}
+
+// Search more than 65535 elements on the host machine, which is not possible
+// using a uint16_t index. The microcontrollers don't have enough RAM, so just
+// verify that the uint32_t versions compile and work on a smaller array.
+#if defined(EPOXY_DUINO)
+const uint32_t LARGE_DATA_SIZE = 70000;
+#else
+const uint32_t LARGE_DATA_SIZE = 300;
+#endif
+
+testF(BinarySearchTest, uint32Index) {
+  const uint32_t n = LARGE_DATA_SIZE;
+  uint16_t* data = new uint16_t[n];
+  for (uint32_t i = 0; i < n; i++) {
+    data[i] = i / 2;
+  }
+  uint16_t last = (n - 1) / 2;
+  assertEqual(lowerBound(data, n, last), n - 2);
+  assertEqual(upperBoundBranchless(data, n, last), n);
+  assertEqual(lowerBoundBranchless(data, n, 123), (uint32_t) 246);
+  delete[] data;
+}
+
+//----------------------------------------------------------------------------
+// setup() and loop()
+//----------------------------------------------------------------------------
+
+void setup() {
+#ifndef EPOXY_DUINO
+  delay(1000); // wait for stability on some boards to prevent garbage Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // for the Arduino Leonardo/Micro only
+}
+
+void loop() {
+  aunit::TestRunner::run();
+}
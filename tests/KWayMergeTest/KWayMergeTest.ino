@@ -0,0 +1,168 @@
+#line 2 "KWayMergeTest.ino"
+
+#include <Arduino.h>
+#include <AUnit.h>
+#include <AceCommon.h>
+#include <AceSorting.h>
+
+using aunit::TestRunner;
+using aunit::TestOnce;
+using ace_common::isSorted;
+using ace_common::isReverseSorted;
+using ace_sorting::merge;
+using ace_sorting::kWayMerge;
+using ace_sorting::kWayMergeSink;
+using ace_sorting::insertionSort;
+
+//-----------------------------------------------------------------------------
+
+// An element which remembers its input and its position in the input, to
+// verify the stability of the merge.
+struct Record {
+  uint8_t key;
+  uint8_t input;
+  uint8_t index;
+};
+
+static bool keyLessThan(const Record& a, const Record& b) {
+  return a.key < b.key;
+}
+
+class KWayMergeTest : public TestOnce {
+  public:
+    // Merge K inputs of random sizes (including empty inputs) with few
+    // distinct keys, and verify that the output is sorted by key, and that
+    // equal keys appear in the order of (input, index).
+    template <uint8_t K>
+    void assertKWayMerge() {
+      const uint8_t maxSize = 20;
+      Record data[K][maxSize];
+      const Record* inputs[K];
+      uint16_t sizes[K];
+      uint16_t total = 0;
+      for (uint8_t i = 0; i < K; i++) {
+        sizes[i] = random(maxSize + 1);
+        for (uint8_t j = 0; j < sizes[i]; j++) {
+          data[i][j] = Record{(uint8_t) random(8), i, j};
+        }
+        insertionSort(data[i], sizes[i], keyLessThan);
+        for (uint8_t j = 0; j < sizes[i]; j++) {
+          data[i][j].index = j;
+        }
+        inputs[i] = data[i];
+        total += sizes[i];
+      }
+
+      Record output[K * maxSize];
+      kWayMerge<K>(inputs, sizes, output, keyLessThan);
+
+      uint16_t counts[K] = {};
+      for (uint16_t i = 0; i < total; i++) {
+        const Record& r = output[i];
+        assertEqual(r.index, counts[r.input]);
+        counts[r.input]++;
+        if (i > 0) {
+          const Record& prev = output[i - 1];
+          assertLessOrEqual(prev.key, r.key);
+          if (prev.key == r.key) {
+            assertLessOrEqual(prev.input, r.input);
+          }
+        }
+      }
+      for (uint8_t i = 0; i < K; i++) {
+        assertEqual(counts[i], sizes[i]);
+      }
+    }
+};
+
+testF(KWayMergeTest, merge) {
+  const uint16_t a[] = {1, 3, 5, 7};
+  const uint16_t b[] = {2, 3, 8};
+  uint16_t output[7];
+  merge(a, (uint16_t) 4, b, 3, output);
+  const uint16_t expected[] = {1, 2, 3, 3, 5, 7, 8};
+  for (uint16_t i = 0; i < 7; i++) {
+    assertEqual(output[i], expected[i]);
+  }
+
+  // Empty inputs.
+  merge(a, (uint16_t) 0, b, 3, output);
+  assertEqual(output[0], 2);
+  assertEqual(output[2], 8);
+  merge(a, (uint16_t) 4, b, 0, output);
+  assertEqual(output[3], 7);
+}
+
+// Equal elements are taken from the first input first.
+testF(KWayMergeTest, mergeStable) {
+  const Record a[] = {{1, 0, 0}, {2, 0, 1}};
+  const Record b[] = {{1, 1, 0}, {2, 1, 1}};
+  Record output[4];
+  merge(a, (uint8_t) 2, b, 2, output, keyLessThan);
+  assertEqual(output[0].input, 0);
+  assertEqual(output[1].input, 1);
+  assertEqual(output[2].input, 0);
+  assertEqual(output[3].input, 1);
+}
+
+testF(KWayMergeTest, kWayMerge) {
+  const uint16_t a[] = {1, 4, 9};
+  const uint16_t b[] = {2, 3};
+  const uint16_t c[] = {0, 5, 6, 10};
+  const uint16_t* inputs[] = {a, b, c};
+  const uint16_t sizes[] = {3, 2, 4};
+  uint16_t output[9];
+  kWayMerge<3>(inputs, sizes, output);
+  const uint16_t expected[] = {0, 1, 2, 3, 4, 5, 6, 9, 10};
+  for (uint16_t i = 0; i < 9; i++) {
+    assertEqual(output[i], expected[i]);
+  }
+}
+
+testF(KWayMergeTest, kWayMergeSizes) {
+  assertNoFatalFailure(assertKWayMerge<1>());
+  assertNoFatalFailure(assertKWayMerge<2>());
+  assertNoFatalFailure(assertKWayMerge<3>());
+  assertNoFatalFailure(assertKWayMerge<4>());
+  assertNoFatalFailure(assertKWayMerge<5>());
+  assertNoFatalFailure(assertKWayMerge<7>());
+  assertNoFatalFailure(assertKWayMerge<8>());
+  assertNoFatalFailure(assertKWayMerge<13>());
+  assertNoFatalFailure(assertKWayMerge<16>());
+}
+
+// Merge inputs sorted in reverse order, into a sink which counts them.
+testF(KWayMergeTest, kWayMergeSink) {
+  auto&& greaterThan = [](uint16_t a, uint16_t b) { return a > b; };
+  uint16_t a[] = {9, 5, 1};
+  uint16_t b[] = {8, 7, 6, 2};
+  uint16_t c[] = {4, 3};
+  uint16_t* inputs[] = {a, b, c};
+  const uint8_t sizes[] = {3, 4, 2};
+
+  uint16_t output[9];
+  uint8_t count = 0;
+  kWayMergeSink<3>(inputs, sizes,
+      [&output, &count](uint16_t x) { output[count++] = x; },
+      greaterThan);
+  assertEqual(count, 9);
+  assertTrue(isReverseSorted(output, 9));
+  assertEqual(output[0], 9);
+  assertEqual(output[8], 1);
+}
+
+//----------------------------------------------------------------------------
+// setup() and loop()
+//----------------------------------------------------------------------------
+
+void setup() {
+#ifndef EPOXY_DUINO
+  delay(1000); // wait for stability on some boards to prevent garbage Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // for the Arduino Leonardo/Micro only
+}
+
+void loop() {
+  aunit::TestRunner::run();
+}
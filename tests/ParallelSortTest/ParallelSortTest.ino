@@ -0,0 +1,252 @@
+#line 2 "ParallelSortTest.ino"
+
+// Verify parallelQuickSort() and parallelSampleSort() with a small threshold,
+// so that arrays of a few thousand elements are distributed over the threads.
+// This must be a separate test program from SortingTest because the
+// thresholds are compile-time settings.
+#define ACE_SORTING_PARALLEL_QUICK_SORT_THRESHOLD 64
+#define ACE_SORTING_PARALLEL_SAMPLE_SORT_THRESHOLD 64
+
+#include <Arduino.h>
+#include <AUnit.h>
+#include <AceCommon.h>
+#include <AceSorting.h>
+
+using aunit::TestRunner;
+using aunit::TestOnce;
+using ace_common::isSorted;
+using ace_common::isReverseSorted;
+using ace_sorting::parallelQuickSort;
+using ace_sorting::parallelSampleSort;
+using ace_sorting::shellSortKnuth;
+
+//-----------------------------------------------------------------------------
+
+// Fill data[] with random values, and copy them into expected[].
+template <typename S>
+static void fillArray(uint16_t data[], uint16_t expected[], S n) {
+  for (S i = 0; i < n; ++i) {
+    data[i] = random(65536);
+    expected[i] = data[i];
+  }
+}
+
+// Sort the expected[] copy of the input using a serial sort, and verify that
+// data[] is equal to it. Unlike isSorted(), this detects elements which were
+// lost or duplicated by a race between the threads, or by the distribution of
+// the elements into the buckets.
+template <typename S>
+static bool isEqualToSorted(const uint16_t data[], uint16_t expected[], S n) {
+  shellSortKnuth(expected, n);
+  for (S i = 0; i < n; ++i) {
+    if (data[i] != expected[i]) return false;
+  }
+  return true;
+}
+
+static bool greaterThan(uint16_t a, uint16_t b) {
+  return a > b;
+}
+
+/**
+ * Test fixture shared by both parallel sorts. Each helper accepts a `sort`
+ * lambda expression with the signature `void(uint16_t data[], uint16_t n,
+ * uint8_t numThreads)`, which calls one of them.
+ */
+class ParallelSortTest : public TestOnce {
+  protected:
+    static const uint16_t kDataSize = 5000;
+    static const uint16_t kThreshold = 64;
+
+    void setup() override {
+      TestOnce::setup();
+      mData = new uint16_t[kDataSize];
+      mExpected = new uint16_t[kDataSize];
+      mBuffer = new uint16_t[kDataSize];
+    }
+
+    void teardown() override {
+      delete[] mBuffer;
+      delete[] mExpected;
+      delete[] mData;
+      TestOnce::teardown();
+    }
+
+    // Sort every size below and around the threshold, using the given number
+    // of threads, then the large array.
+    template <typename SORT>
+    void assertSort(SORT&& sort, uint8_t numThreads) {
+      for (uint16_t n = 0; n <= 2 * kThreshold; n += 7) {
+        fillArray(mData, mExpected, n);
+        sort(mData, n, numThreads);
+        assertTrue(isEqualToSorted(mData, mExpected, n));
+      }
+
+      fillArray(mData, mExpected, kDataSize);
+      assertFalse(isSorted(mData, kDataSize));
+      sort(mData, kDataSize, numThreads);
+      assertTrue(isEqualToSorted(mData, mExpected, kDataSize));
+    }
+
+    // Sorted, reverse sorted, few unique keys, and a single repeated key,
+    // which produce unbalanced partitions or buckets.
+    template <typename SORT>
+    void assertPatterns(SORT&& sort) {
+      for (uint16_t i = 0; i < kDataSize; ++i) {
+        mData[i] = mExpected[i] = i;
+      }
+      sort(mData, kDataSize, 4);
+      assertTrue(isEqualToSorted(mData, mExpected, kDataSize));
+
+      for (uint16_t i = 0; i < kDataSize; ++i) {
+        mData[i] = mExpected[i] = kDataSize - i;
+      }
+      sort(mData, kDataSize, 4);
+      assertTrue(isEqualToSorted(mData, mExpected, kDataSize));
+
+      for (uint16_t i = 0; i < kDataSize; ++i) {
+        mData[i] = mExpected[i] = random(4);
+      }
+      sort(mData, kDataSize, 4);
+      assertTrue(isEqualToSorted(mData, mExpected, kDataSize));
+
+      for (uint8_t numThreads = 1; numThreads <= 4; numThreads++) {
+        for (uint16_t i = 0; i < kDataSize; ++i) {
+          mData[i] = mExpected[i] = 42;
+        }
+        sort(mData, kDataSize, numThreads);
+        assertTrue(isEqualToSorted(mData, mExpected, kDataSize));
+      }
+    }
+
+    // Verify that mData[] is the reverse of the sorted mExpected[].
+    void assertReverseOfExpected() {
+      assertTrue(isReverseSorted(mData, kDataSize));
+      shellSortKnuth(mExpected, kDataSize);
+      for (uint16_t i = 0; i < kDataSize; ++i) {
+        assertEqual(mExpected[kDataSize - 1 - i], mData[i]);
+      }
+    }
+
+    uint16_t* mData;
+    uint16_t* mExpected;
+    uint16_t* mBuffer;
+};
+
+//-----------------------------------------------------------------------------
+// parallelQuickSort()
+//-----------------------------------------------------------------------------
+
+static void quickSort(uint16_t data[], uint16_t n, uint8_t numThreads) {
+  parallelQuickSort(data, n, numThreads);
+}
+
+testF(ParallelSortTest, quickSortThreads) {
+  assertNoFatalFailure(assertSort(quickSort, 1));
+  assertNoFatalFailure(assertSort(quickSort, 2));
+  assertNoFatalFailure(assertSort(quickSort, 3));
+  assertNoFatalFailure(assertSort(quickSort, 4));
+}
+
+// numThreads == 0 selects the number of hardware threads.
+testF(ParallelSortTest, quickSortHardwareThreads) {
+  assertNoFatalFailure(assertSort(quickSort, 0));
+}
+
+testF(ParallelSortTest, quickSortReverse) {
+  fillArray(mData, mExpected, kDataSize);
+  parallelQuickSort(mData, kDataSize, greaterThan, 4);
+  assertNoFatalFailure(assertReverseOfExpected());
+}
+
+// The identical keys are skipped over by partitionEqual().
+testF(ParallelSortTest, quickSortPatterns) {
+  assertNoFatalFailure(assertPatterns(quickSort));
+}
+
+// More than 65535 elements, using a uint32_t index.
+testF(ParallelSortTest, quickSortUint32Index) {
+  const uint32_t dataSize = 100000;
+  uint16_t* data = new uint16_t[dataSize];
+  uint16_t* expected = new uint16_t[dataSize];
+  fillArray(data, expected, dataSize);
+  parallelQuickSort(data, dataSize, 4);
+  assertTrue(isEqualToSorted(data, expected, dataSize));
+  delete[] expected;
+  delete[] data;
+}
+
+//-----------------------------------------------------------------------------
+// parallelSampleSort()
+//-----------------------------------------------------------------------------
+
+testF(ParallelSortTest, sampleSortThreads) {
+  auto sampleSort = [this](uint16_t data[], uint16_t n, uint8_t numThreads) {
+    parallelSampleSort(data, n, mBuffer, numThreads);
+  };
+  assertNoFatalFailure(assertSort(sampleSort, 1));
+  assertNoFatalFailure(assertSort(sampleSort, 2));
+  assertNoFatalFailure(assertSort(sampleSort, 3));
+  assertNoFatalFailure(assertSort(sampleSort, 4));
+}
+
+// numThreads == 0 selects the number of hardware threads.
+testF(ParallelSortTest, sampleSortHardwareThreads) {
+  auto sampleSort = [this](uint16_t data[], uint16_t n, uint8_t numThreads) {
+    parallelSampleSort(data, n, mBuffer, numThreads);
+  };
+  assertNoFatalFailure(assertSort(sampleSort, 0));
+}
+
+// More buckets than elements near the threshold, so that the number of
+// samples is limited by the size of the array.
+testF(ParallelSortTest, sampleSortManyThreads) {
+  auto sampleSort = [this](uint16_t data[], uint16_t n, uint8_t numThreads) {
+    parallelSampleSort(data, n, mBuffer, numThreads);
+  };
+  assertNoFatalFailure(assertSort(sampleSort, 32));
+}
+
+testF(ParallelSortTest, sampleSortReverse) {
+  fillArray(mData, mExpected, kDataSize);
+  parallelSampleSort(mData, kDataSize, mBuffer, greaterThan, 4);
+  assertNoFatalFailure(assertReverseOfExpected());
+}
+
+// The few unique keys and the identical keys fill the equality buckets.
+testF(ParallelSortTest, sampleSortPatterns) {
+  auto sampleSort = [this](uint16_t data[], uint16_t n, uint8_t numThreads) {
+    parallelSampleSort(data, n, mBuffer, numThreads);
+  };
+  assertNoFatalFailure(assertPatterns(sampleSort));
+}
+
+// More than 65535 elements, using a uint32_t index.
+testF(ParallelSortTest, sampleSortUint32Index) {
+  const uint32_t dataSize = 100000;
+  uint16_t* data = new uint16_t[dataSize];
+  uint16_t* expected = new uint16_t[dataSize];
+  uint16_t* buffer = new uint16_t[dataSize];
+  fillArray(data, expected, dataSize);
+  parallelSampleSort(data, dataSize, buffer, 4);
+  assertTrue(isEqualToSorted(data, expected, dataSize));
+  delete[] buffer;
+  delete[] expected;
+  delete[] data;
+}
+
+//----------------------------------------------------------------------------
+// setup() and loop()
+//----------------------------------------------------------------------------
+
+void setup() {
+#ifndef EPOXY_DUINO
+  delay(1000); // wait for stability on some boards to prevent garbage Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // for the Arduino Leonardo/Micro only
+}
+
+void loop() {
+  aunit::TestRunner::run();
+}
@@ -0,0 +1,130 @@
+#line 2 "QuickSortThresholdTest.ino"
+
+// Verify the quickSortXxx() functions when small partitions are delegated to
+// insertionSort(). This must be a separate test program from SortingTest
+// because ACE_SORTING_QUICK_SORT_THRESHOLD is a compile-time setting.
+#define ACE_SORTING_QUICK_SORT_THRESHOLD 8
+
+#include <Arduino.h>
+#include <AUnit.h>
+#include <AceCommon.h>
+#include <AceSorting.h>
+
+using aunit::TestRunner;
+using aunit::TestOnce;
+using ace_common::isSorted;
+using ace_common::isReverseSorted;
+using ace_sorting::quickSortMiddle;
+using ace_sorting::quickSortMedian;
+using ace_sorting::quickSortMedianSwapped;
+using ace_sorting::quickSortIterative;
+using ace_sorting::quickSort3Way;
+
+//-----------------------------------------------------------------------------
+
+typedef void (*SortFunction)(uint16_t data[], uint16_t n);
+
+static void fillArray(uint16_t data[], uint16_t n) {
+  for (uint16_t i = 0; i < n; ++i) {
+    data[i] = random(65536);
+  }
+}
+
+class QuickSortThresholdTest : public TestOnce {
+  protected:
+    static const uint16_t kDataSize = 300;
+
+    // Sort every size from 0 to 2 * ACE_SORTING_QUICK_SORT_THRESHOLD + 1, to
+    // exercise the partitions just below, at and above the threshold, then a
+    // larger array where the cutoff happens many times.
+    void assertSort(SortFunction sortFunction) {
+      uint16_t data[kDataSize];
+      for (uint16_t n = 0; n <= 2 * ACE_SORTING_QUICK_SORT_THRESHOLD + 1; n++) {
+        fillArray(data, n);
+        sortFunction(data, n);
+        assertTrue(isSorted(data, n));
+      }
+
+      fillArray(data, kDataSize);
+      assertFalse(isSorted(data, kDataSize));
+      sortFunction(data, kDataSize);
+      assertTrue(isSorted(data, kDataSize));
+    }
+};
+
+testF(QuickSortThresholdTest, quickSortMiddle) {
+  assertSort(quickSortMiddle<uint16_t>);
+}
+
+testF(QuickSortThresholdTest, quickSortMedian) {
+  assertSort(quickSortMedian<uint16_t>);
+}
+
+testF(QuickSortThresholdTest, quickSortMedianSwapped) {
+  assertSort(quickSortMedianSwapped<uint16_t>);
+}
+
+testF(QuickSortThresholdTest, quickSortIterative) {
+  assertSort(quickSortIterative<uint16_t>);
+}
+
+testF(QuickSortThresholdTest, quickSort3Way) {
+  assertSort(quickSort3Way<uint16_t>);
+}
+
+//----------------------------------------------------------------------------
+
+auto&& greaterThan = [](const uint16_t& a, const uint16_t& b) {
+  return a > b;
+};
+
+testF(QuickSortThresholdTest, quickSortMiddleReverse) {
+  uint16_t data[kDataSize];
+  fillArray(data, kDataSize);
+  quickSortMiddle(data, kDataSize, greaterThan);
+  assertTrue(isReverseSorted(data, kDataSize));
+}
+
+testF(QuickSortThresholdTest, quickSortMedianReverse) {
+  uint16_t data[kDataSize];
+  fillArray(data, kDataSize);
+  quickSortMedian(data, kDataSize, greaterThan);
+  assertTrue(isReverseSorted(data, kDataSize));
+}
+
+testF(QuickSortThresholdTest, quickSortMedianSwappedReverse) {
+  uint16_t data[kDataSize];
+  fillArray(data, kDataSize);
+  quickSortMedianSwapped(data, kDataSize, greaterThan);
+  assertTrue(isReverseSorted(data, kDataSize));
+}
+
+testF(QuickSortThresholdTest, quickSortIterativeReverse) {
+  uint16_t data[kDataSize];
+  fillArray(data, kDataSize);
+  quickSortIterative(data, kDataSize, greaterThan);
+  assertTrue(isReverseSorted(data, kDataSize));
+}
+
+testF(QuickSortThresholdTest, quickSort3WayReverse) {
+  uint16_t data[kDataSize];
+  fillArray(data, kDataSize);
+  quickSort3Way(data, kDataSize, greaterThan);
+  assertTrue(isReverseSorted(data, kDataSize));
+}
+
+//----------------------------------------------------------------------------
+// setup() and loop()
+//----------------------------------------------------------------------------
+
+void setup() {
+#ifndef EPOXY_DUINO
+  delay(1000); // wait for stability on some boards to prevent garbage Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // for the Arduino Leonardo/Micro only
+}
+
+void loop() {
+  aunit::TestRunner::run();
+}
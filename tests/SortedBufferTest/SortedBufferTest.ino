@@ -0,0 +1,259 @@
+#line 2 "SortedBufferTest.ino"
+
+#include <Arduino.h>
+#include <AUnit.h>
+#include <AceCommon.h>
+#include <AceSorting.h>
+
+using aunit::TestRunner;
+using aunit::TestOnce;
+using ace_common::isSorted;
+using ace_common::isReverseSorted;
+using ace_sorting::SortedBuffer;
+using ace_sorting::RunningMedian;
+using ace_sorting::insertionSort;
+
+//-----------------------------------------------------------------------------
+
+class SortedBufferTest : public TestOnce {};
+
+testF(SortedBufferTest, empty) {
+  SortedBuffer<uint16_t, 4> buffer;
+  assertEqual(buffer.capacity(), 4);
+  assertEqual(buffer.size(), 0);
+  assertTrue(buffer.isEmpty());
+  assertFalse(buffer.isFull());
+  assertFalse(buffer.remove(1));
+}
+
+testF(SortedBufferTest, insert) {
+  SortedBuffer<uint16_t, 5> buffer;
+  assertTrue(buffer.insert(30));
+  assertTrue(buffer.insert(10));
+  assertTrue(buffer.insert(40));
+  assertTrue(buffer.insert(20));
+  assertTrue(buffer.insert(20));
+  assertTrue(buffer.isFull());
+  assertFalse(buffer.insert(5));
+
+  assertEqual(buffer.size(), 5);
+  assertEqual(buffer.min(), 10);
+  assertEqual(buffer.max(), 40);
+  assertEqual(buffer.at(0), 10);
+  assertEqual(buffer.at(1), 20);
+  assertEqual(buffer.at(2), 20);
+  assertEqual(buffer.at(3), 30);
+  assertEqual(buffer.at(4), 40);
+
+  buffer.clear();
+  assertTrue(buffer.isEmpty());
+}
+
+testF(SortedBufferTest, remove) {
+  SortedBuffer<uint16_t, 5> buffer;
+  buffer.insert(30);
+  buffer.insert(10);
+  buffer.insert(20);
+  buffer.insert(20);
+
+  assertFalse(buffer.remove(15));
+  assertFalse(buffer.remove(50));
+  assertTrue(buffer.remove(20));
+  assertEqual(buffer.size(), 3);
+  assertEqual(buffer.at(1), 20);
+  assertTrue(buffer.remove(20));
+  assertFalse(buffer.remove(20));
+
+  buffer.removeAt(0);
+  assertEqual(buffer.size(), 1);
+  assertEqual(buffer.min(), 30);
+  assertEqual(buffer.max(), 30);
+  assertTrue(buffer.remove(30));
+  assertTrue(buffer.isEmpty());
+}
+
+// Equal elements are kept in the order of insertion.
+testF(SortedBufferTest, stable) {
+  struct Record {
+    uint8_t key;
+    uint8_t id;
+  };
+  auto lessThan = [](const Record& a, const Record& b) {
+    return a.key < b.key;
+  };
+  SortedBuffer<Record, 4, decltype(lessThan)> buffer(lessThan);
+  buffer.insert({2, 0});
+  buffer.insert({1, 1});
+  buffer.insert({2, 2});
+  buffer.insert({1, 3});
+  assertEqual(buffer.at(0).id, 1);
+  assertEqual(buffer.at(1).id, 3);
+  assertEqual(buffer.at(2).id, 0);
+  assertEqual(buffer.at(3).id, 2);
+}
+
+testF(SortedBufferTest, reverse) {
+  auto greaterThan = [](uint16_t a, uint16_t b) { return a > b; };
+  SortedBuffer<uint16_t, 100, decltype(greaterThan)> buffer(greaterThan);
+  for (uint16_t i = 0; i < 100; i++) {
+    buffer.insert(random(65536));
+  }
+  assertTrue(isReverseSorted(buffer.data(), buffer.size()));
+}
+
+// Compare against an array which is sorted again after each update, using a
+// sliding window of random samples.
+testF(SortedBufferTest, slidingWindow) {
+  const uint16_t windowSize = 16;
+  SortedBuffer<uint16_t, windowSize> buffer;
+  uint16_t window[windowSize];
+  uint16_t sorted[windowSize];
+
+  for (uint16_t i = 0; i < 200; i++) {
+    uint16_t sample = random(32);
+    if (buffer.isFull()) {
+      assertTrue(buffer.remove(window[i % windowSize]));
+    }
+    window[i % windowSize] = sample;
+    assertTrue(buffer.insert(sample));
+
+    uint16_t n = buffer.size();
+    memcpy(sorted, window, n * sizeof(uint16_t));
+    insertionSort(sorted, n);
+    assertTrue(isSorted(buffer.data(), n));
+    for (uint16_t j = 0; j < n; j++) {
+      assertEqual(buffer.at(j), sorted[j]);
+    }
+  }
+}
+
+testF(SortedBufferTest, replace) {
+  SortedBuffer<uint16_t, 5> buffer;
+  buffer.insert(10);
+  buffer.insert(20);
+  buffer.insert(30);
+  buffer.insert(40);
+  buffer.insert(50);
+
+  assertFalse(buffer.replace(25, 1));
+
+  // Move to the left.
+  assertTrue(buffer.replace(40, 15));
+  assertEqual(buffer.at(0), 10);
+  assertEqual(buffer.at(1), 15);
+  assertEqual(buffer.at(2), 20);
+  assertEqual(buffer.at(3), 30);
+  assertEqual(buffer.at(4), 50);
+
+  // Move to the right, to the end.
+  assertTrue(buffer.replace(10, 60));
+  assertEqual(buffer.at(0), 15);
+  assertEqual(buffer.at(3), 50);
+  assertEqual(buffer.at(4), 60);
+
+  // Same position.
+  assertTrue(buffer.replace(30, 31));
+  assertEqual(buffer.at(2), 31);
+  assertEqual(buffer.size(), 5);
+}
+
+// replace() must give the same result as remove() followed by insert().
+testF(SortedBufferTest, replaceRandom) {
+  const uint16_t capacity = 16;
+  SortedBuffer<uint16_t, capacity> buffer;
+  SortedBuffer<uint16_t, capacity> expected;
+  for (uint16_t i = 0; i < capacity; i++) {
+    uint16_t x = random(8);
+    buffer.insert(x);
+    expected.insert(x);
+  }
+
+  for (uint16_t i = 0; i < 200; i++) {
+    uint16_t oldValue = buffer.at(random(capacity));
+    uint16_t newValue = random(8);
+    assertTrue(buffer.replace(oldValue, newValue));
+    expected.remove(oldValue);
+    expected.insert(newValue);
+    for (uint16_t j = 0; j < capacity; j++) {
+      assertEqual(buffer.at(j), expected.at(j));
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+class RunningMedianTest : public TestOnce {
+  public:
+    // Compare the running median and percentiles against a sorted copy of the
+    // last 'window' samples.
+    template <uint16_t WINDOW>
+    void assertRunningMedian() {
+      RunningMedian<uint16_t, WINDOW> filter;
+      uint16_t samples[300];
+      uint16_t sorted[WINDOW];
+      const uint8_t percents[] = {0, 10, 50, 95, 100};
+
+      for (uint16_t i = 0; i < 300; i++) {
+        samples[i] = random(64);
+        filter.add(samples[i]);
+
+        uint16_t n = (i + 1 < WINDOW) ? i + 1 : WINDOW;
+        assertEqual(filter.size(), n);
+        memcpy(sorted, samples + i + 1 - n, n * sizeof(uint16_t));
+        insertionSort(sorted, n);
+
+        assertEqual(filter.median(), sorted[n / 2]);
+        assertEqual(filter.min(), sorted[0]);
+        assertEqual(filter.max(), sorted[n - 1]);
+        for (uint8_t percent : percents) {
+          // Nearest-rank percentile.
+          uint16_t rank = (percent * n + 99) / 100;
+          if (rank > 0) rank--;
+          assertEqual(filter.percentile(percent), sorted[rank]);
+        }
+      }
+    }
+};
+
+testF(RunningMedianTest, oddWindow) {
+  assertNoFatalFailure(assertRunningMedian<7>());
+}
+
+testF(RunningMedianTest, evenWindow) {
+  assertNoFatalFailure(assertRunningMedian<20>());
+}
+
+testF(RunningMedianTest, clear) {
+  RunningMedian<uint16_t, 3> filter;
+  assertEqual(filter.window(), 3);
+  filter.add(5);
+  filter.add(1);
+  filter.add(3);
+  filter.add(4);
+  assertTrue(filter.isFull());
+  assertEqual(filter.median(), 3);
+  assertEqual(filter.min(), 1);
+  assertEqual(filter.max(), 4);
+
+  filter.clear();
+  assertEqual(filter.size(), 0);
+  filter.add(9);
+  assertEqual(filter.median(), 9);
+  assertEqual(filter.percentile(95), 9);
+}
+
+//----------------------------------------------------------------------------
+// setup() and loop()
+//----------------------------------------------------------------------------
+
+void setup() {
+#ifndef EPOXY_DUINO
+  delay(1000); // wait for stability on some boards to prevent garbage Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // for the Arduino Leonardo/Micro only
+}
+
+void loop() {
+  aunit::TestRunner::run();
+}
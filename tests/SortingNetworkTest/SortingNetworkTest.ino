@@ -0,0 +1,172 @@
+#line 2 "SortingNetworkTest.ino"
+
+// Verify the sortingNetworkXxx() functions for each element type supported by
+// the SIMD networks, and the SIMD sorting of the small partitions of the
+// quickSortXxx() functions. The Makefile compiles this program with SSE4.1 on
+// x86-64, so this must be a separate test program from SortingTest.
+#define ACE_SORTING_QUICK_SORT_THRESHOLD 32
+
+#include <Arduino.h>
+#include <AUnit.h>
+#include <AceCommon.h>
+#include <AceSorting.h>
+
+using aunit::TestRunner;
+using aunit::TestOnce;
+using ace_common::isSorted;
+using ace_common::isReverseSorted;
+using ace_sorting::insertionSort;
+using ace_sorting::sortingNetwork8;
+using ace_sorting::sortingNetwork16;
+using ace_sorting::sortingNetwork32;
+using ace_sorting::sortFixed;
+using ace_sorting::quickSortMiddle;
+using ace_sorting::quickSortMedianSwapped;
+using ace_sorting::quickSort3Way;
+
+//-----------------------------------------------------------------------------
+
+static void fillRandom(uint16_t& x) { x = random(65536); }
+static void fillRandom(int16_t& x) { x = (int16_t) random(65536); }
+static void fillRandom(uint32_t& x) {
+  x = ((uint32_t) random(65536) << 16) | random(65536);
+}
+static void fillRandom(int32_t& x) {
+  x = ((int32_t) random(65536) << 16) | random(65536);
+}
+static void fillRandom(float& x) {
+  x = ((float) random(20000) - 10000.0) / 100.0;
+}
+
+class SortingNetworkTest : public TestOnce {
+  protected:
+    static const uint8_t kNumTrials = 20;
+
+    // Sort random arrays of N elements with the network, and verify that the
+    // result is identical to the result of insertionSort(). The random values
+    // are reduced to a few unique values on every other trial, to check the
+    // handling of duplicates.
+    template <uint8_t N, typename T>
+    void assertNetwork(void (*sortFunction)(T data[])) {
+      T data[N];
+      T expected[N];
+      for (uint8_t k = 0; k < kNumTrials; k++) {
+        for (uint8_t i = 0; i < N; i++) {
+          fillRandom(data[i]);
+          if (k % 2) data[i] = (T) ((int16_t) data[i] % 4);
+          expected[i] = data[i];
+        }
+        insertionSort(expected, N);
+
+        sortFunction(data);
+        for (uint8_t i = 0; i < N; i++) {
+          assertEqual(expected[i], data[i]);
+        }
+      }
+    }
+
+    template <typename T>
+    void assertNetworks() {
+      assertNoFatalFailure(assertNetwork<8>(sortingNetwork8<T>));
+      assertNoFatalFailure(assertNetwork<16>(sortingNetwork16<T>));
+      assertNoFatalFailure(assertNetwork<32>(sortingNetwork32<T>));
+    }
+};
+
+testF(SortingNetworkTest, uint16) {
+  assertNetworks<uint16_t>();
+}
+
+testF(SortingNetworkTest, int16) {
+  assertNetworks<int16_t>();
+}
+
+testF(SortingNetworkTest, uint32) {
+  assertNetworks<uint32_t>();
+}
+
+testF(SortingNetworkTest, int32) {
+  assertNetworks<int32_t>();
+}
+
+testF(SortingNetworkTest, float) {
+  assertNetworks<float>();
+}
+
+// sortFixed() delegates to the SIMD networks for N = 8, 16 and 32.
+testF(SortingNetworkTest, sortFixed) {
+  assertNoFatalFailure(assertNetwork<8>(sortFixed<8, int32_t>));
+  assertNoFatalFailure(assertNetwork<16>(sortFixed<16, uint16_t>));
+  assertNoFatalFailure(assertNetwork<32>(sortFixed<32, float>));
+  assertNoFatalFailure(assertNetwork<5>(sortFixed<5, int16_t>));
+}
+
+// The 2-argument version always uses the scalar network.
+testF(SortingNetworkTest, reverse) {
+  auto&& greaterThan = [](const uint16_t& a, const uint16_t& b) {
+    return a > b;
+  };
+
+  uint16_t data[32];
+  for (uint8_t i = 0; i < 32; i++) {
+    fillRandom(data[i]);
+  }
+  sortingNetwork8(data, greaterThan);
+  assertTrue(isReverseSorted(data, 8));
+  sortingNetwork16(data, greaterThan);
+  assertTrue(isReverseSorted(data, 16));
+  sortingNetwork32(data, greaterThan);
+  assertTrue(isReverseSorted(data, 32));
+}
+
+//-----------------------------------------------------------------------------
+
+// Sort every size from 0 to 2 * ACE_SORTING_QUICK_SORT_THRESHOLD + 1, so that
+// the small partitions are padded to each size of the network.
+class SmallPartitionTest : public TestOnce {
+  protected:
+    static const uint16_t kMaxSize = 2 * ACE_SORTING_QUICK_SORT_THRESHOLD + 1;
+
+    template <typename T>
+    void assertSort(void (*sortFunction)(T data[], uint16_t n)) {
+      T data[kMaxSize];
+      for (uint16_t n = 0; n <= kMaxSize; n++) {
+        for (uint16_t i = 0; i < n; i++) {
+          fillRandom(data[i]);
+        }
+        sortFunction(data, n);
+        assertTrue(isSorted(data, n));
+      }
+    }
+};
+
+testF(SmallPartitionTest, quickSortMiddle) {
+  assertNoFatalFailure(assertSort<uint16_t>(quickSortMiddle<uint16_t>));
+  assertNoFatalFailure(assertSort<int32_t>(quickSortMiddle<int32_t>));
+}
+
+testF(SmallPartitionTest, quickSortMedianSwapped) {
+  assertNoFatalFailure(assertSort<int16_t>(quickSortMedianSwapped<int16_t>));
+  assertNoFatalFailure(assertSort<uint32_t>(quickSortMedianSwapped<uint32_t>));
+}
+
+testF(SmallPartitionTest, quickSort3Way) {
+  assertNoFatalFailure(assertSort<uint16_t>(quickSort3Way<uint16_t>));
+  assertNoFatalFailure(assertSort<float>(quickSort3Way<float>));
+}
+
+//----------------------------------------------------------------------------
+// setup() and loop()
+//----------------------------------------------------------------------------
+
+void setup() {
+#ifndef EPOXY_DUINO
+  delay(1000); // wait for stability on some boards to prevent garbage Serial
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // for the Arduino Leonardo/Micro only
+}
+
+void loop() {
+  aunit::TestRunner::run();
+}
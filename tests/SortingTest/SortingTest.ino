@@ -19,9 +19,30 @@ using ace_sorting::combSort13;
 using ace_sorting::combSort13m;
 using ace_sorting::combSort133;
 using ace_sorting::combSort133m;
+using ace_sorting::heapSort;
+using ace_sorting::partialSort;
+using ace_sorting::topK;
+using ace_sorting::nthElement;
+using ace_sorting::median;
 using ace_sorting::quickSortMiddle;
 using ace_sorting::quickSortMedian;
 using ace_sorting::quickSortMedianSwapped;
+using ace_sorting::quickSortIterative;
+using ace_sorting::quickSort3Way;
+using ace_sorting::quickSortBlock;
+using ace_sorting::quickSortSimd;
+using ace_sorting::pdqSort;
+using ace_sorting::introSort;
+using ace_sorting::mergeSort;
+using ace_sorting::mergeSortInPlace;
+using ace_sorting::timSort;
+using ace_sorting::radixSort;
+using ace_sorting::radixSortInPlace;
+using ace_sorting::countingSort;
+using ace_sorting::sortingNetwork8;
+using ace_sorting::sortingNetwork16;
+using ace_sorting::sortingNetwork32;
+using ace_sorting::sortFixed;
 
 //-----------------------------------------------------------------------------
 
@@ -140,6 +161,153 @@ testF(SortingTest, combSort133m) {
   assertSort(combSort133m<uint16_t>);
 }
 
+testF(SortingTest, heapSort) {
+  assertSort(heapSort<uint16_t>);
+}
+
+// Verify that the first k elements are sorted, and that none of the remaining
+// elements is smaller than them.
+static bool isPartiallySorted(const uint16_t data[], uint16_t n, uint16_t k) {
+  if (! isSorted(data, k)) return false;
+  for (uint16_t i = k; i < n; ++i) {
+    if (data[i] < data[k - 1]) return false;
+  }
+  return true;
+}
+
+testF(SortingTest, partialSort) {
+  const uint16_t dataSize = 300;
+  uint16_t data[dataSize];
+  const uint16_t ks[] = {1, 2, 10, 150, 299, 300};
+  for (uint16_t k : ks) {
+    fillArray(data, dataSize);
+    partialSort(data, dataSize, k);
+    assertTrue(isPartiallySorted(data, dataSize, k));
+  }
+
+  // k == 0 does nothing, k > n sorts the whole array.
+  fillArray(data, dataSize);
+  data[0] = 1;
+  data[1] = 0;
+  partialSort(data, dataSize, 0);
+  assertEqual(data[0], 1);
+  partialSort(data, dataSize, 1000);
+  assertTrue(isSorted(data, dataSize));
+}
+
+testF(SortingTest, topK) {
+  const uint16_t dataSize = 300;
+  uint16_t data[dataSize];
+  uint16_t copy[dataSize];
+  uint16_t result[10];
+  fillArray(data, dataSize);
+  for (uint16_t i = 0; i < dataSize; ++i) {
+    copy[i] = data[i];
+  }
+
+  // The result must be the same as the last 10 elements of the sorted array,
+  // and data[] must not be modified.
+  topK(data, dataSize, result, 10);
+  assertTrue(isReverseSorted(result, 10));
+  for (uint16_t i = 0; i < dataSize; ++i) {
+    assertEqual(data[i], copy[i]);
+  }
+  heapSort(copy, dataSize);
+  for (uint16_t i = 0; i < 10; ++i) {
+    assertEqual(result[i], copy[dataSize - 1 - i]);
+  }
+
+  // Fewer elements than k.
+  topK(data, (uint16_t) 3, result, 10);
+  assertTrue(isReverseSorted(result, 3));
+}
+
+// Verify that data[k] is equal to sorted[k], that no element before it is
+// larger, and that no element after it is smaller.
+static bool isNthElement(
+    const uint16_t data[], const uint16_t sorted[], uint16_t n, uint16_t k) {
+  if (data[k] != sorted[k]) return false;
+  for (uint16_t i = 0; i < k; ++i) {
+    if (data[k] < data[i]) return false;
+  }
+  for (uint16_t i = k + 1; i < n; ++i) {
+    if (data[i] < data[k]) return false;
+  }
+  return true;
+}
+
+// Fill with random data (numKeys = 0), or with only 'numKeys' unique keys.
+static void fillKeys(uint16_t data[], uint16_t n, uint16_t numKeys) {
+  for (uint16_t i = 0; i < n; ++i) {
+    data[i] = (numKeys == 0) ? random(65536) : random(numKeys);
+  }
+}
+
+testF(SortingTest, nthElement) {
+  const uint16_t dataSize = 300;
+  uint16_t data[dataSize];
+  uint16_t sorted[dataSize];
+  const uint16_t ks[] = {0, 1, 10, 150, 285, 299};
+  const uint16_t numKeys[] = {0, 16, 1};
+  for (uint16_t keys : numKeys) {
+    for (uint16_t k : ks) {
+      fillKeys(data, dataSize, keys);
+      memcpy(sorted, data, sizeof(data));
+      heapSort(sorted, dataSize);
+      nthElement(data, dataSize, k);
+      assertTrue(isNthElement(data, sorted, dataSize, k));
+    }
+  }
+
+  // Already sorted and reverse sorted data.
+  nthElement(data, dataSize, 100);
+  assertTrue(isNthElement(data, sorted, dataSize, 100));
+  for (uint16_t i = 0; i < dataSize; ++i) {
+    data[i] = dataSize - i;
+    sorted[i] = i + 1;
+  }
+  nthElement(data, dataSize, 200);
+  assertTrue(isNthElement(data, sorted, dataSize, 200));
+
+  // k >= n does nothing.
+  uint16_t list2[2] = {4, 1};
+  nthElement(list2, (uint16_t) 2, 2);
+  assertEqual(list2[0], 4);
+}
+
+// Force the median of medians fallback from the start.
+testF(SortingTest, nthElementMedianOfMedians) {
+  const uint16_t dataSize = 300;
+  uint16_t data[dataSize];
+  uint16_t sorted[dataSize];
+  auto&& lessThan = [](uint16_t a, uint16_t b) { return a < b; };
+  const uint16_t ks[] = {0, 7, 150, 299};
+  const uint16_t numKeys[] = {0, 16, 1};
+  for (uint16_t keys : numKeys) {
+    for (uint16_t k : ks) {
+      fillKeys(data, dataSize, keys);
+      memcpy(sorted, data, sizeof(data));
+      heapSort(sorted, dataSize);
+      ace_sorting::internal::nthElementIterative(
+          data, dataSize, k, (uint8_t) 0, lessThan);
+      assertTrue(isNthElement(data, sorted, dataSize, k));
+    }
+  }
+}
+
+testF(SortingTest, median) {
+  uint16_t list5[5];
+  memcpy(list5, LIST5, sizeof(LIST5));
+  assertEqual(median(list5, (uint16_t) 5), 30);
+
+  // Upper median if n is even.
+  uint16_t list4[4] = {40, 10, 30, 20};
+  assertEqual(median(list4, (uint16_t) 4), 30);
+
+  uint16_t list1[1] = {7};
+  assertEqual(median(list1, (uint16_t) 1), 7);
+}
+
 testF(SortingTest, quickSortMiddle) {
   assertSort(quickSortMiddle<uint16_t>);
 }
@@ -152,6 +320,282 @@ testF(SortingTest, quickSortMedianSwapped) {
   assertSort(quickSortMedianSwapped<uint16_t>);
 }
 
+testF(SortingTest, quickSortIterative) {
+  assertSort(quickSortIterative<uint16_t>);
+}
+
+testF(SortingTest, quickSort3Way) {
+  assertSort(quickSort3Way<uint16_t>);
+}
+
+// Sort an array with only a few unique keys, which exercises the grouping of
+// the elements equal to the pivot. Also sort an array where all elements are
+// equal.
+testF(SortingTest, quickSort3WayFewUnique) {
+  const uint16_t dataSize = 300;
+  uint16_t* data = new uint16_t[dataSize];
+  for (uint16_t i = 0; i < dataSize; ++i) {
+    data[i] = random(4);
+  }
+  assertFalse(isSorted(data, dataSize));
+  quickSort3Way(data, dataSize);
+  assertTrue(isSorted(data, dataSize));
+
+  for (uint16_t i = 0; i < dataSize; ++i) {
+    data[i] = 7;
+  }
+  quickSort3Way(data, dataSize);
+  assertTrue(isSorted(data, dataSize));
+  delete[] data;
+}
+
+testF(SortingTest, quickSortBlock) {
+  assertSort(quickSortBlock<uint16_t>);
+}
+
+// Sort arrays larger than several ACE_SORTING_QUICK_SORT_BLOCK_SIZE blocks,
+// which exercises the leftover offsets at the end of the block partition.
+// Then sort few unique keys, identical keys, and a non-arithmetic type which
+// uses the classic partition instead of the branchless one.
+struct BlockKey {
+  uint16_t key;
+  bool operator<(const BlockKey& other) const { return key < other.key; }
+};
+
+testF(SortingTest, quickSortBlockLarge) {
+  const uint16_t dataSize = 1000;
+  uint16_t* data = new uint16_t[dataSize];
+  for (uint16_t n = 17; n < dataSize; n += n / 2) {
+    fillArray(data, n);
+    quickSortBlock(data, n);
+    assertTrue(isSorted(data, n));
+  }
+
+  for (uint16_t i = 0; i < dataSize; ++i) {
+    data[i] = random(4);
+  }
+  quickSortBlock(data, dataSize);
+  assertTrue(isSorted(data, dataSize));
+
+  // All keys identical, which are gathered by partitionEqual().
+  for (uint16_t i = 0; i < dataSize; ++i) {
+    data[i] = 42;
+  }
+  quickSortBlock(data, dataSize);
+  assertTrue(isSorted(data, dataSize));
+  delete[] data;
+
+  BlockKey keys[300];
+  for (uint16_t i = 0; i < 300; ++i) {
+    keys[i].key = random(65536);
+  }
+  quickSortBlock(keys, (uint16_t) 300);
+  for (uint16_t i = 1; i < 300; ++i) {
+    assertFalse(keys[i].key < keys[i - 1].key);
+  }
+}
+
+testF(SortingTest, quickSortBlockFloat) {
+  float data[300];
+  for (uint16_t i = 0; i < 300; ++i) {
+    data[i] = ((float) random(20000) - 10000.0) / 100.0;
+  }
+  quickSortBlock(data, (uint16_t) 300);
+  assertTrue(isSorted(data, 300));
+}
+
+testF(SortingTest, quickSortSimd) {
+  assertSort(quickSortSimd<uint16_t>);
+}
+
+// Sort each type supported by the AVX2 partition, with values near the ends
+// of the range of the type (which need the unsigned comparison of uint32_t),
+// and a type which is not supported.
+testF(SortingTest, quickSortSimdTypes) {
+  const uint16_t dataSize = 300;
+
+  int32_t int32s[dataSize];
+  for (uint16_t i = 0; i < dataSize; ++i) {
+    int32s[i] = (int32_t) (((uint32_t) random(65536) << 16) | random(65536));
+  }
+  quickSortSimd(int32s, dataSize);
+  assertTrue(isSorted(int32s, dataSize));
+
+  uint32_t uint32s[dataSize];
+  for (uint16_t i = 0; i < dataSize; ++i) {
+    uint32s[i] = (i & 0x1) ? random(4) : 0xFFFFFFFF - random(4);
+  }
+  quickSortSimd(uint32s, dataSize);
+  assertTrue(isSorted(uint32s, dataSize));
+
+  float floats[dataSize];
+  for (uint16_t i = 0; i < dataSize; ++i) {
+    floats[i] = ((float) random(20000) - 10000.0) / 100.0;
+  }
+  quickSortSimd(floats, dataSize);
+  assertTrue(isSorted(floats, dataSize));
+
+  uint8_t uint8s[dataSize];
+  for (uint16_t i = 0; i < dataSize; ++i) {
+    uint8s[i] = random(256);
+  }
+  quickSortSimd(uint8s, dataSize);
+  assertTrue(isSorted(uint8s, dataSize));
+}
+
+testF(SortingTest, pdqSort) {
+  assertSort(pdqSort<uint16_t>);
+}
+
+// Sort the patterns detected by pdqSort(): sorted, reverse sorted, sorted
+// with a few elements appended at the end, and few unique keys.
+testF(SortingTest, pdqSortPatterns) {
+  const uint16_t dataSize = 1000;
+  uint16_t* data = new uint16_t[dataSize];
+
+  for (uint16_t i = 0; i < dataSize; ++i) {
+    data[i] = i;
+  }
+  pdqSort(data, dataSize);
+  assertTrue(isSorted(data, dataSize));
+
+  for (uint16_t i = 0; i < dataSize; ++i) {
+    data[i] = dataSize - i;
+  }
+  pdqSort(data, dataSize);
+  assertTrue(isSorted(data, dataSize));
+
+  for (uint16_t i = dataSize - 10; i < dataSize; ++i) {
+    data[i] = random(dataSize);
+  }
+  assertFalse(isSorted(data, dataSize));
+  pdqSort(data, dataSize);
+  assertTrue(isSorted(data, dataSize));
+
+  for (uint16_t i = 0; i < dataSize; ++i) {
+    data[i] = random(4);
+  }
+  pdqSort(data, dataSize);
+  assertTrue(isSorted(data, dataSize));
+
+  // Organ pipe: ascending then descending.
+  for (uint16_t i = 0; i < dataSize; ++i) {
+    data[i] = (i < dataSize / 2) ? i : dataSize - i;
+  }
+  pdqSort(data, dataSize);
+  assertTrue(isSorted(data, dataSize));
+  delete[] data;
+}
+
+// partialInsertionSort() must give up on the rotated array [m+1..2m, 1..m],
+// whose every insertion moves an element by m positions. A move of 256 used to
+// overflow the move counter, which made it sort the whole array in O(n^2).
+testF(SortingTest, pdqSortPartialInsertionLimit) {
+  auto&& lessThan = [](const uint16_t& a, const uint16_t& b) {
+    return a < b;
+  };
+  const uint16_t m = 256;
+  uint16_t* data = new uint16_t[2 * m];
+  for (uint16_t i = 0; i < m; ++i) {
+    data[i] = m + 1 + i;
+    data[m + i] = 1 + i;
+  }
+  assertFalse(ace_sorting::internal::partialInsertionSort(
+      data, (uint16_t) (2 * m), lessThan));
+  delete[] data;
+}
+
+testF(SortingTest, introSort) {
+  assertSort(introSort<uint16_t>);
+}
+
+// Force introSort() to switch to its fallback algorithm immediately, to verify
+// the code path that is normally triggered only by adversarial input data.
+static void introSortFallback(uint16_t data[], uint16_t n) {
+  auto&& lessThan = [](const uint16_t& a, const uint16_t& b) {
+    return a < b;
+  };
+  ace_sorting::internal::introSortRecursive(data, n, 0, lessThan);
+}
+
+testF(SortingTest, introSortFallback) {
+  assertSort(introSortFallback);
+}
+
+// mergeSort() requires a scratch buffer of n/2 elements, so wrap it into the
+// SortFunction signature.
+static uint16_t mergeBuffer[150];
+
+static void mergeSortWithBuffer(uint16_t data[], uint16_t n) {
+  mergeSort(data, n, mergeBuffer);
+}
+
+testF(SortingTest, mergeSort) {
+  assertSort(mergeSortWithBuffer);
+}
+
+testF(SortingTest, mergeSortInPlace) {
+  assertSort(mergeSortInPlace<uint16_t>);
+}
+
+// timSort() requires the same n/2 scratch buffer as mergeSort().
+static void timSortWithBuffer(uint16_t data[], uint16_t n) {
+  timSort(data, n, mergeBuffer);
+}
+
+testF(SortingTest, timSort) {
+  assertSort(timSortWithBuffer);
+}
+
+// Sort data made of sorted runs, ascending and descending, which are merged
+// in galloping mode.
+testF(SortingTest, timSortRuns) {
+  const uint16_t dataSize = 300;
+  uint16_t data[dataSize];
+  for (uint16_t i = 0; i < dataSize; ++i) {
+    data[i] = i;
+  }
+  timSort(data, dataSize, mergeBuffer);
+  assertTrue(isSorted(data, dataSize));
+
+  for (uint16_t i = 0; i < dataSize; ++i) {
+    data[i] = dataSize - i;
+  }
+  timSort(data, dataSize, mergeBuffer);
+  assertTrue(isSorted(data, dataSize));
+
+  // 4 runs of 75 elements, interleaved with each other.
+  for (uint16_t i = 0; i < dataSize; ++i) {
+    data[i] = (i % 75) * 4 + (i / 75);
+  }
+  assertFalse(isSorted(data, dataSize));
+  timSort(data, dataSize, mergeBuffer);
+  assertTrue(isSorted(data, dataSize));
+
+  // 3 runs, the middle one descending, which do not overlap much.
+  for (uint16_t i = 0; i < dataSize; ++i) {
+    data[i] = (i < 100) ? 200 + i : (i < 200) ? 300 - i : i - 100;
+  }
+  timSort(data, dataSize, mergeBuffer);
+  assertTrue(isSorted(data, dataSize));
+}
+
+// radixSort() requires a scratch buffer of n elements.
+static uint16_t radixBuffer[300];
+
+static void radixSortWithBuffer(uint16_t data[], uint16_t n) {
+  radixSort(data, n, radixBuffer);
+}
+
+testF(SortingTest, radixSort) {
+  assertSort(radixSortWithBuffer);
+}
+
+testF(SortingTest, radixSortInPlace) {
+  assertSort(radixSortInPlace<uint16_t>);
+}
+
+
 //----------------------------------------------------------------------------
 
 /*
@@ -209,6 +653,37 @@ testF(ReverseSortingTest, selectionSort) {
   assertTrue(isReverseSorted(mData, kDataSize));
 }
 
+// The 10 largest, in descending order.
+testF(ReverseSortingTest, partialSort) {
+  partialSort(mData, kDataSize, 10, greaterThan);
+  assertTrue(isReverseSorted(mData, 10));
+  for (uint16_t i = 10; i < kDataSize; ++i) {
+    assertLessOrEqual(mData[i], mData[9]);
+  }
+}
+
+// The 10 smallest, in ascending order.
+testF(ReverseSortingTest, topK) {
+  uint16_t result[10];
+  topK(mData, kDataSize, result, 10, greaterThan);
+  assertTrue(isSorted(result, 10));
+  heapSort(mData, kDataSize);
+  for (uint16_t i = 0; i < 10; ++i) {
+    assertEqual(result[i], mData[i]);
+  }
+}
+
+// The 10th largest.
+testF(ReverseSortingTest, nthElement) {
+  nthElement(mData, kDataSize, 9, greaterThan);
+  for (uint16_t i = 0; i < 9; ++i) {
+    assertLessOrEqual(mData[9], mData[i]);
+  }
+  for (uint16_t i = 10; i < kDataSize; ++i) {
+    assertLessOrEqual(mData[i], mData[9]);
+  }
+}
+
 testF(ReverseSortingTest, shellSortClassic) {
   assertFalse(isSorted(mData, kDataSize));
   shellSortClassic(mData, kDataSize, greaterThan);
@@ -251,6 +726,12 @@ testF(ReverseSortingTest, combSort133m) {
   assertTrue(isReverseSorted(mData, kDataSize));
 }
 
+testF(ReverseSortingTest, heapSort) {
+  assertFalse(isSorted(mData, kDataSize));
+  heapSort(mData, kDataSize, greaterThan);
+  assertTrue(isReverseSorted(mData, kDataSize));
+}
+
 testF(ReverseSortingTest, quickSortMiddle) {
   assertFalse(isSorted(mData, kDataSize));
   quickSortMiddle(mData, kDataSize, greaterThan);
@@ -269,6 +750,576 @@ testF(ReverseSortingTest, quickSortMedianSwapped) {
   assertTrue(isReverseSorted(mData, kDataSize));
 }
 
+testF(ReverseSortingTest, quickSortIterative) {
+  assertFalse(isSorted(mData, kDataSize));
+  quickSortIterative(mData, kDataSize, greaterThan);
+  assertTrue(isReverseSorted(mData, kDataSize));
+}
+
+testF(ReverseSortingTest, quickSort3Way) {
+  assertFalse(isSorted(mData, kDataSize));
+  quickSort3Way(mData, kDataSize, greaterThan);
+  assertTrue(isReverseSorted(mData, kDataSize));
+}
+
+testF(ReverseSortingTest, quickSortBlock) {
+  assertFalse(isSorted(mData, kDataSize));
+  quickSortBlock(mData, kDataSize, greaterThan);
+  assertTrue(isReverseSorted(mData, kDataSize));
+}
+
+testF(ReverseSortingTest, pdqSort) {
+  assertFalse(isSorted(mData, kDataSize));
+  pdqSort(mData, kDataSize, greaterThan);
+  assertTrue(isReverseSorted(mData, kDataSize));
+}
+
+testF(ReverseSortingTest, introSort) {
+  assertFalse(isSorted(mData, kDataSize));
+  introSort(mData, kDataSize, greaterThan);
+  assertTrue(isReverseSorted(mData, kDataSize));
+}
+
+testF(ReverseSortingTest, mergeSort) {
+  assertFalse(isSorted(mData, kDataSize));
+  mergeSort(mData, kDataSize, mergeBuffer, greaterThan);
+  assertTrue(isReverseSorted(mData, kDataSize));
+}
+
+testF(ReverseSortingTest, mergeSortInPlace) {
+  assertFalse(isSorted(mData, kDataSize));
+  mergeSortInPlace(mData, kDataSize, greaterThan);
+  assertTrue(isReverseSorted(mData, kDataSize));
+}
+
+testF(ReverseSortingTest, timSort) {
+  assertFalse(isSorted(mData, kDataSize));
+  timSort(mData, kDataSize, mergeBuffer, greaterThan);
+  assertTrue(isReverseSorted(mData, kDataSize));
+}
+
+//----------------------------------------------------------------------------
+// Verify that the stable sorting algorithms are stable by sorting records with
+// only a few unique keys, then checking that the records with equal keys
+// retain their original order.
+//----------------------------------------------------------------------------
+
+struct Record {
+  uint16_t key;
+  uint16_t index;
+};
+
+auto&& recordLessThan = [](const Record& a, const Record& b) {
+  return a.key < b.key;
+};
+
+class StableSortingTest : public TestOnce {
+  protected:
+    const uint16_t kDataSize = 300;
+
+    void setup() override {
+      TestOnce::setup();
+      mData = new Record[kDataSize];
+      for (uint16_t i = 0; i < kDataSize; ++i) {
+        mData[i].key = random(8);
+        mData[i].index = i;
+      }
+    }
+
+    void teardown() override {
+      delete[] mData;
+      TestOnce::teardown();
+    }
+
+    void assertStable() {
+      for (uint16_t i = 1; i < kDataSize; ++i) {
+        assertLessOrEqual(mData[i - 1].key, mData[i].key);
+        if (mData[i - 1].key == mData[i].key) {
+          assertLess(mData[i - 1].index, mData[i].index);
+        }
+      }
+    }
+
+    Record* mData;
+};
+
+testF(StableSortingTest, insertionSort) {
+  insertionSort(mData, kDataSize, recordLessThan);
+  assertNoFatalFailure(assertStable());
+}
+
+testF(StableSortingTest, mergeSort) {
+  Record* buffer = new Record[kDataSize / 2];
+  mergeSort(mData, kDataSize, buffer, recordLessThan);
+  delete[] buffer;
+  assertNoFatalFailure(assertStable());
+}
+
+testF(StableSortingTest, mergeSortInPlace) {
+  mergeSortInPlace(mData, kDataSize, recordLessThan);
+  assertNoFatalFailure(assertStable());
+}
+
+testF(StableSortingTest, timSort) {
+  Record* buffer = new Record[kDataSize / 2];
+  timSort(mData, kDataSize, buffer, recordLessThan);
+  assertNoFatalFailure(assertStable());
+
+  // Sorted runs with long blocks of equal keys, which are merged in galloping
+  // mode.
+  for (uint16_t i = 0; i < kDataSize; ++i) {
+    mData[i].key = (i % 100) / 13;
+    mData[i].index = i;
+  }
+  timSort(mData, kDataSize, buffer, recordLessThan);
+  delete[] buffer;
+  assertNoFatalFailure(assertStable());
+}
+
+testF(StableSortingTest, radixSort) {
+  Record* buffer = new Record[kDataSize];
+  radixSort(mData, kDataSize, buffer, [](const Record& r) { return r.key; });
+  delete[] buffer;
+  assertNoFatalFailure(assertStable());
+}
+
+testF(StableSortingTest, countingSort) {
+  Record* buffer = new Record[kDataSize];
+  uint16_t counts[8];
+  countingSort(mData, kDataSize, 7, counts, buffer,
+      [](const Record& r) { return r.key; });
+  delete[] buffer;
+  assertNoFatalFailure(assertStable());
+}
+
+//----------------------------------------------------------------------------
+// Verify radixSort() for key types other than uint16_t.
+//----------------------------------------------------------------------------
+
+class RadixSortTest : public TestOnce {
+  protected:
+    static const uint16_t kDataSize = 100;
+};
+
+testF(RadixSortTest, int16) {
+  int16_t data[kDataSize];
+  int16_t buffer[kDataSize];
+  for (uint16_t i = 0; i < kDataSize; ++i) {
+    data[i] = (int16_t) random(65536);
+  }
+  data[0] = -32768;
+  data[1] = 32767;
+  data[2] = -1;
+  data[3] = 0;
+
+  radixSort(data, kDataSize, buffer);
+  assertTrue(isSorted(data, kDataSize));
+}
+
+testF(RadixSortTest, int16InPlace) {
+  int16_t data[kDataSize];
+  for (uint16_t i = 0; i < kDataSize; ++i) {
+    data[i] = (int16_t) random(65536);
+  }
+  data[0] = -32768;
+  data[1] = 32767;
+  data[2] = -1;
+  data[3] = 0;
+
+  radixSortInPlace(data, kDataSize);
+  assertTrue(isSorted(data, kDataSize));
+}
+
+testF(RadixSortTest, int32) {
+  int32_t data[kDataSize];
+  int32_t buffer[kDataSize];
+  for (uint16_t i = 0; i < kDataSize; ++i) {
+    data[i] = ((int32_t) random(65536) << 16) | random(65536);
+  }
+
+  radixSort(data, kDataSize, buffer);
+  assertTrue(isSorted(data, kDataSize));
+}
+
+testF(RadixSortTest, int32InPlace) {
+  int32_t data[kDataSize];
+  for (uint16_t i = 0; i < kDataSize; ++i) {
+    data[i] = ((int32_t) random(65536) << 16) | random(65536);
+  }
+
+  radixSortInPlace(data, kDataSize);
+  assertTrue(isSorted(data, kDataSize));
+}
+
+testF(RadixSortTest, uint8) {
+  uint8_t data[kDataSize];
+  uint8_t buffer[kDataSize];
+  for (uint16_t i = 0; i < kDataSize; ++i) {
+    data[i] = random(256);
+  }
+
+  radixSort(data, kDataSize, buffer);
+  assertTrue(isSorted(data, kDataSize));
+}
+
+testF(RadixSortTest, float) {
+  float data[kDataSize];
+  float buffer[kDataSize];
+  for (uint16_t i = 0; i < kDataSize; ++i) {
+    data[i] = ((float) random(20000) - 10000.0) / 100.0;
+  }
+  data[0] = 0.0;
+  data[1] = -0.0;
+  data[2] = 1e30;
+  data[3] = -1e30;
+
+  radixSort(data, kDataSize, buffer);
+  assertTrue(isSorted(data, kDataSize));
+}
+
+testF(RadixSortTest, floatInPlace) {
+  float data[kDataSize];
+  for (uint16_t i = 0; i < kDataSize; ++i) {
+    data[i] = ((float) random(20000) - 10000.0) / 100.0;
+  }
+  data[0] = 0.0;
+  data[1] = -0.0;
+  data[2] = 1e30;
+  data[3] = -1e30;
+
+  radixSortInPlace(data, kDataSize);
+  assertTrue(isSorted(data, kDataSize));
+}
+
+// Sort in reverse order by inverting the key.
+testF(RadixSortTest, reverse) {
+  uint16_t data[kDataSize];
+  uint16_t buffer[kDataSize];
+  fillArray(data, kDataSize);
+
+  radixSort(data, kDataSize, buffer, [](uint16_t a) -> uint16_t {
+    return ~a;
+  });
+  assertTrue(isReverseSorted(data, kDataSize));
+}
+
+testF(RadixSortTest, reverseInPlace) {
+  uint16_t data[kDataSize];
+  fillArray(data, kDataSize);
+
+  radixSortInPlace(data, kDataSize, [](uint16_t a) -> uint16_t {
+    return ~a;
+  });
+  assertTrue(isReverseSorted(data, kDataSize));
+}
+
+// Keys with only a few unique values fill only a few buckets, and an array of
+// equal keys skips all the digits.
+testF(RadixSortTest, fewUniqueInPlace) {
+  uint16_t data[kDataSize];
+  for (uint16_t i = 0; i < kDataSize; ++i) {
+    data[i] = random(4) * 1000;
+  }
+  radixSortInPlace(data, kDataSize);
+  assertTrue(isSorted(data, kDataSize));
+
+  for (uint16_t i = 0; i < kDataSize; ++i) {
+    data[i] = 7;
+  }
+  radixSortInPlace(data, kDataSize);
+  assertTrue(isSorted(data, kDataSize));
+}
+
+//----------------------------------------------------------------------------
+// Verify countingSort() for small ranges of keys.
+//----------------------------------------------------------------------------
+
+class CountingSortTest : public TestOnce {
+  protected:
+    static const uint16_t kDataSize = 100;
+};
+
+// A maxKey of 255 as a uint8_t must not overflow the loops over the keys.
+testF(CountingSortTest, uint8) {
+  uint8_t data[kDataSize];
+  for (uint16_t i = 0; i < kDataSize; ++i) {
+    data[i] = random(256);
+  }
+  data[0] = 0;
+  data[1] = 255;
+
+  uint16_t counts[256];
+  countingSort(data, kDataSize, (uint8_t) 255, counts);
+  assertTrue(isSorted(data, kDataSize));
+  assertEqual(0, data[0]);
+  assertEqual(255, data[kDataSize - 1]);
+}
+
+// 10-bit ADC readings.
+testF(CountingSortTest, adc) {
+  uint16_t data[kDataSize];
+  for (uint16_t i = 0; i < kDataSize; ++i) {
+    data[i] = random(1024);
+  }
+
+  uint16_t counts[1024];
+  countingSort(data, kDataSize, 1023, counts);
+  assertTrue(isSorted(data, kDataSize));
+}
+
+// A literal `n`, whose type is int, must not conflict with the type of the
+// `counts` array.
+testF(CountingSortTest, literalSize) {
+  uint16_t data[100];
+  for (uint16_t i = 0; i < 100; ++i) {
+    data[i] = random(256);
+  }
+
+  uint16_t counts[256];
+  countingSort(data, 100, 255, counts);
+  assertTrue(isSorted(data, (uint16_t) 100));
+
+  uint16_t buffer[100];
+  countingSort(data, 100, 255, counts, buffer,
+      [](uint16_t a) -> uint16_t { return 255 - a; });
+  assertTrue(isReverseSorted(data, (uint16_t) 100));
+}
+
+// Sort in reverse order by returning (maxKey - key).
+testF(CountingSortTest, reverse) {
+  uint8_t data[kDataSize];
+  for (uint16_t i = 0; i < kDataSize; ++i) {
+    data[i] = random(16);
+  }
+
+  uint8_t buffer[kDataSize];
+  uint16_t counts[16];
+  countingSort(data, kDataSize, 15, counts, buffer,
+      [](uint8_t a) -> uint8_t { return 15 - a; });
+  assertTrue(isReverseSorted(data, kDataSize));
+}
+
+//----------------------------------------------------------------------------
+// Verify the sortingNetworkXxx() functions. This program is compiled without
+// SIMD instructions, so this tests the scalar networks. The SIMD networks are
+// tested by SortingNetworkTest.
+//----------------------------------------------------------------------------
+
+testF(SortingTest, sortingNetwork) {
+  uint16_t data[32];
+
+  fillArray(data, 8);
+  sortingNetwork8(data);
+  assertTrue(isSorted(data, 8));
+
+  fillArray(data, 16);
+  sortingNetwork16(data);
+  assertTrue(isSorted(data, 16));
+
+  fillArray(data, 32);
+  sortingNetwork32(data);
+  assertTrue(isSorted(data, 32));
+}
+
+testF(SortingTest, sortingNetworkInt32) {
+  int32_t data[32];
+  for (uint16_t i = 0; i < 32; ++i) {
+    data[i] = ((int32_t) random(65536) << 16) | random(65536);
+  }
+  sortingNetwork32(data);
+  assertTrue(isSorted(data, 32));
+}
+
+//----------------------------------------------------------------------------
+// Verify sortFixed() for the sizes of typical sensor windows, and the sizes
+// which are delegated to the SIMD networks when they are enabled.
+//----------------------------------------------------------------------------
+
+class SortFixedTest : public TestOnce {
+  protected:
+    template <uint8_t N>
+    void assertSortFixed() {
+      uint16_t data[N];
+      for (uint8_t k = 0; k < 10; k++) {
+        fillArray(data, N);
+        sortFixed<N>(data);
+        assertTrue(isSorted(data, N));
+      }
+    }
+};
+
+testF(SortFixedTest, sizes) {
+  assertNoFatalFailure(assertSortFixed<1>());
+  assertNoFatalFailure(assertSortFixed<2>());
+  assertNoFatalFailure(assertSortFixed<3>());
+  assertNoFatalFailure(assertSortFixed<5>());
+  assertNoFatalFailure(assertSortFixed<7>());
+  assertNoFatalFailure(assertSortFixed<8>());
+  assertNoFatalFailure(assertSortFixed<13>());
+  assertNoFatalFailure(assertSortFixed<16>());
+  assertNoFatalFailure(assertSortFixed<32>());
+}
+
+testF(SortFixedTest, float) {
+  float data[5] = {1.5, -2.0, 0.0, 100.0, -0.5};
+  sortFixed<5>(data);
+  assertTrue(isSorted(data, 5));
+}
+
+testF(SortFixedTest, reverse) {
+  uint16_t data[9];
+  fillArray(data, 9);
+  sortFixed<9>(data, [](uint16_t a, uint16_t b) { return a > b; });
+  assertTrue(isReverseSorted(data, 9));
+}
+
+//----------------------------------------------------------------------------
+// Verify that the index type S can be something other than uint16_t.
+//----------------------------------------------------------------------------
+
+typedef void (*SortFunction8)(uint16_t data[], uint8_t n);
+typedef void (*SortFunction32)(uint16_t data[], uint32_t n);
+
+class IndexTypeTest : public TestOnce {
+  public:
+    // The largest array that can be indexed by a uint8_t.
+    void assertSortUint8(SortFunction8 sortFunction) {
+      const uint8_t dataSize = 255;
+      uint16_t data[dataSize];
+      fillArray(data, dataSize);
+
+      assertFalse(isSorted(data, dataSize));
+      sortFunction(data, dataSize);
+      assertTrue(isSorted(data, dataSize));
+    }
+
+    void assertSortUint32(SortFunction32 sortFunction, uint32_t dataSize) {
+      uint16_t* data = new uint16_t[dataSize];
+      for (uint32_t i = 0; i < dataSize; ++i) {
+        data[i] = random(65536);
+      }
+
+      assertFalse(isSorted(data, dataSize));
+      sortFunction(data, dataSize);
+      assertTrue(isSorted(data, dataSize));
+      delete[] data;
+    }
+};
+
+static void mergeSortUint8(uint16_t data[], uint8_t n) {
+  mergeSort(data, n, mergeBuffer);
+}
+
+static void mergeSortUint32(uint16_t data[], uint32_t n) {
+  uint16_t* buffer = new uint16_t[n / 2];
+  mergeSort(data, n, buffer);
+  delete[] buffer;
+}
+
+static void timSortUint8(uint16_t data[], uint8_t n) {
+  timSort(data, n, mergeBuffer);
+}
+
+static void timSortUint32(uint16_t data[], uint32_t n) {
+  uint16_t* buffer = new uint16_t[n / 2];
+  timSort(data, n, buffer);
+  delete[] buffer;
+}
+
+static void radixSortUint8(uint16_t data[], uint8_t n) {
+  radixSort(data, n, radixBuffer);
+}
+
+static void radixSortUint32(uint16_t data[], uint32_t n) {
+  uint16_t* buffer = new uint16_t[n];
+  radixSort(data, n, buffer);
+  delete[] buffer;
+}
+
+testF(IndexTypeTest, uint8Index) {
+  assertNoFatalFailure(assertSortUint8(bubbleSort<uint16_t, uint8_t>));
+  assertNoFatalFailure(assertSortUint8(insertionSort<uint16_t, uint8_t>));
+  assertNoFatalFailure(assertSortUint8(selectionSort<uint16_t, uint8_t>));
+  assertNoFatalFailure(assertSortUint8(shellSortClassic<uint16_t, uint8_t>));
+  assertNoFatalFailure(assertSortUint8(shellSortKnuth<uint16_t, uint8_t>));
+  assertNoFatalFailure(assertSortUint8(shellSortTokuda<uint16_t, uint8_t>));
+  assertNoFatalFailure(assertSortUint8(combSort13<uint16_t, uint8_t>));
+  assertNoFatalFailure(assertSortUint8(combSort13m<uint16_t, uint8_t>));
+  assertNoFatalFailure(assertSortUint8(combSort133<uint16_t, uint8_t>));
+  assertNoFatalFailure(assertSortUint8(combSort133m<uint16_t, uint8_t>));
+  assertNoFatalFailure(assertSortUint8(heapSort<uint16_t, uint8_t>));
+  assertNoFatalFailure(assertSortUint8(quickSortMiddle<uint16_t, uint8_t>));
+  assertNoFatalFailure(assertSortUint8(quickSortMedian<uint16_t, uint8_t>));
+  assertNoFatalFailure(
+      assertSortUint8(quickSortMedianSwapped<uint16_t, uint8_t>));
+  assertNoFatalFailure(
+      assertSortUint8(quickSortIterative<uint16_t, uint8_t>));
+  assertNoFatalFailure(assertSortUint8(quickSort3Way<uint16_t, uint8_t>));
+  assertNoFatalFailure(assertSortUint8(quickSortBlock<uint16_t, uint8_t>));
+  assertNoFatalFailure(assertSortUint8(pdqSort<uint16_t, uint8_t>));
+  assertNoFatalFailure(assertSortUint8(introSort<uint16_t, uint8_t>));
+  assertNoFatalFailure(assertSortUint8(mergeSortUint8));
+  assertNoFatalFailure(assertSortUint8(timSortUint8));
+  assertNoFatalFailure(assertSortUint8(mergeSortInPlace<uint16_t, uint8_t>));
+  assertNoFatalFailure(assertSortUint8(radixSortUint8));
+  assertNoFatalFailure(assertSortUint8(radixSortInPlace<uint16_t, uint8_t>));
+}
+
+// Sort more than 65535 elements on the host machine, which is not possible
+// using a uint16_t index. The microcontrollers don't have enough RAM, so just
+// verify that the uint32_t versions compile and work on a smaller array.
+#if defined(EPOXY_DUINO)
+const uint32_t LARGE_DATA_SIZE = 70000;
+#else
+const uint32_t LARGE_DATA_SIZE = 300;
+#endif
+
+testF(IndexTypeTest, uint32Index) {
+  // O(N^2) algorithms take too long for large N.
+  assertNoFatalFailure(
+      assertSortUint32(insertionSort<uint16_t, uint32_t>, 300));
+
+  assertNoFatalFailure(assertSortUint32(
+      shellSortClassic<uint16_t, uint32_t>, LARGE_DATA_SIZE));
+  assertNoFatalFailure(assertSortUint32(
+      shellSortKnuth<uint16_t, uint32_t>, LARGE_DATA_SIZE));
+  assertNoFatalFailure(assertSortUint32(
+      shellSortTokuda<uint16_t, uint32_t>, LARGE_DATA_SIZE));
+  assertNoFatalFailure(assertSortUint32(
+      combSort13<uint16_t, uint32_t>, LARGE_DATA_SIZE));
+  assertNoFatalFailure(assertSortUint32(
+      combSort13m<uint16_t, uint32_t>, LARGE_DATA_SIZE));
+  assertNoFatalFailure(assertSortUint32(
+      combSort133<uint16_t, uint32_t>, LARGE_DATA_SIZE));
+  assertNoFatalFailure(assertSortUint32(
+      combSort133m<uint16_t, uint32_t>, LARGE_DATA_SIZE));
+  assertNoFatalFailure(assertSortUint32(
+      heapSort<uint16_t, uint32_t>, LARGE_DATA_SIZE));
+  assertNoFatalFailure(assertSortUint32(
+      quickSortMiddle<uint16_t, uint32_t>, LARGE_DATA_SIZE));
+  assertNoFatalFailure(assertSortUint32(
+      quickSortMedian<uint16_t, uint32_t>, LARGE_DATA_SIZE));
+  assertNoFatalFailure(assertSortUint32(
+      quickSortMedianSwapped<uint16_t, uint32_t>, LARGE_DATA_SIZE));
+  assertNoFatalFailure(assertSortUint32(
+      quickSortIterative<uint16_t, uint32_t>, LARGE_DATA_SIZE));
+  assertNoFatalFailure(assertSortUint32(
+      quickSort3Way<uint16_t, uint32_t>, LARGE_DATA_SIZE));
+  assertNoFatalFailure(assertSortUint32(
+      quickSortBlock<uint16_t, uint32_t>, LARGE_DATA_SIZE));
+  assertNoFatalFailure(assertSortUint32(
+      pdqSort<uint16_t, uint32_t>, LARGE_DATA_SIZE));
+  assertNoFatalFailure(assertSortUint32(
+      introSort<uint16_t, uint32_t>, LARGE_DATA_SIZE));
+  assertNoFatalFailure(assertSortUint32(mergeSortUint32, LARGE_DATA_SIZE));
+  assertNoFatalFailure(assertSortUint32(timSortUint32, LARGE_DATA_SIZE));
+  assertNoFatalFailure(assertSortUint32(
+      mergeSortInPlace<uint16_t, uint32_t>, LARGE_DATA_SIZE));
+  assertNoFatalFailure(assertSortUint32(radixSortUint32, LARGE_DATA_SIZE));
+  assertNoFatalFailure(assertSortUint32(
+      radixSortInPlace<uint16_t, uint32_t>, LARGE_DATA_SIZE));
+}
+
 //----------------------------------------------------------------------------
 // setup() and loop()
 //----------------------------------------------------------------------------